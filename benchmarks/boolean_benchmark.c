@@ -0,0 +1,20 @@
+#include "boolean_benchmark.h"
+
+#include <time.h>
+
+// the current time, for measuring how long something takes
+double boolean_benchmark_seconds(void) {
+	struct timespec now;
+	if (timespec_get(&now, TIME_UTC) != TIME_UTC) {
+		return 0.0;
+	}
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+// a xorshift generator, so that every run sees the same inputs
+uint64_t boolean_benchmark_random_word(uint64_t *state) {
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
@@ -0,0 +1,9 @@
+#ifndef BOOLEAN_BENCHMARK_H
+#define BOOLEAN_BENCHMARK_H
+
+#include <stdint.h>
+
+double boolean_benchmark_seconds(void);
+uint64_t boolean_benchmark_random_word(uint64_t *state);
+
+#endif
@@ -0,0 +1,112 @@
+#include "boolean_benchmark.h"
+
+#include <bool_tool/boolean_expression.h>
+#include <bool_tool/boolean_factoring.h>
+#include <bool_tool/boolean_implicants.h>
+#include <bool_tool/boolean_lanes.h>
+#include <bool_tool/boolean_minterms.h>
+#include <bool_tool/boolean_status.h>
+#include <bool_tool/boolean_variables.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define VARIABLES_MAXIMUM 14
+
+// compares the truth tables of the expressions over the variables a word of rows at a time
+static bool equivalent(
+	const struct boolean_expression *expression_1,
+	const struct boolean_expression *expression_2,
+	const struct boolean_variables *variables
+) {
+	struct boolean_lanes lanes = boolean_lanes_from_variables(variables);
+	for (uint64_t word = 0; word < boolean_lanes_words_count(&lanes); word++) {
+		if (boolean_lanes_evaluate(&lanes, expression_1, word) !=
+			boolean_lanes_evaluate(&lanes, expression_2, word)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// factors the minimal sums of products of random functions that are true on three quarters of
+// their rows, reporting the literals before and after, and checking that the factored expression
+// is still the same function
+int main(void) {
+	struct boolean_variables variables =
+		boolean_variables_from_string("a,b,c,d,e,f,g,h,i,j,k,l,m,n");
+	struct boolean_minterms minterms = {
+		.data = malloc(sizeof(*minterms.data) << VARIABLES_MAXIMUM),
+		.length = 0,
+	};
+	if (minterms.data == NULL) {
+		boolean_variables_drop(&variables);
+		return EXIT_FAILURE;
+	}
+
+	int exit_status = EXIT_SUCCESS;
+	uint64_t state = UINT64_C(0x9E3779B97F4A7C15);
+	for (size_t variables_count = 8; variables_count <= VARIABLES_MAXIMUM; variables_count += 2) {
+		struct boolean_variables function_variables = {
+			.data = variables.data,
+			.length = variables_count,
+		};
+
+		minterms.length = 0;
+		for (uint64_t minterm = 0; minterm < (UINT64_C(1) << variables_count); minterm++) {
+			if ((boolean_benchmark_random_word(&state) & 3U) != 0) {
+				minterms.data[minterms.length++] = minterm;
+			}
+		}
+
+		struct boolean_implicants implicants;
+		struct boolean_status status = boolean_implicants_from_minterms(
+			&minterms,
+			&function_variables,
+			NULL,
+			NULL,
+			&implicants
+		);
+		if (status.type != boolean_status_type_success) {
+			boolean_status_print(&status);
+			boolean_status_drop(&status);
+			continue;
+		}
+		status = boolean_implicants_minimalize(&implicants, &minterms, NULL, NULL);
+		boolean_status_drop(&status);
+
+		double start = boolean_benchmark_seconds();
+		struct boolean_factoring_costs costs;
+		struct boolean_expression expression = boolean_expression_factored_from_implicants(
+			&implicants,
+			&function_variables,
+			NULL,
+			&costs
+		);
+		double elapsed = boolean_benchmark_seconds() - start;
+
+		struct boolean_expression sum_of_products =
+			boolean_expression_from_implicants(&implicants, &function_variables);
+		bool same = equivalent(&expression, &sum_of_products, &function_variables);
+		boolean_expression_drop(&sum_of_products);
+
+		printf(
+			"%2zu variables %5zu products %6zu literals factored into %6zu %8.3f s%s\n",
+			variables_count,
+			implicants.length,
+			costs.sum_of_products,
+			costs.factored,
+			elapsed,
+			same ? "" : " differs"
+		);
+		exit_status = same ? exit_status : EXIT_FAILURE;
+
+		boolean_expression_drop(&expression);
+		boolean_implicants_drop(&implicants);
+	}
+
+	boolean_minterms_drop(&minterms);
+	boolean_variables_drop(&variables);
+
+	return exit_status;
+}
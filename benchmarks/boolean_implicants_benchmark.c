@@ -0,0 +1,57 @@
+#include "boolean_benchmark.h"
+
+#include <bool_tool/boolean_implicants.h>
+#include <bool_tool/boolean_minterms.h>
+#include <bool_tool/boolean_status.h>
+#include <bool_tool/boolean_variables.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define VARIABLES_COUNT 16
+
+// finds the prime implicants of a random function of 16 variables that is true on three quarters
+// of its rows, which keeps the groups of the table large, the scalar scan is measured by the same
+// benchmark built with BOOL_TOOL_NO_SIMD defined
+int main(void) {
+	struct boolean_variables variables =
+		boolean_variables_from_string("a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p");
+	struct boolean_minterms minterms = {
+		.data = malloc(sizeof(*minterms.data) << VARIABLES_COUNT),
+		.length = 0,
+	};
+	if (minterms.data == NULL) {
+		boolean_variables_drop(&variables);
+		return EXIT_FAILURE;
+	}
+
+	uint64_t state = UINT64_C(0x9E3779B97F4A7C15);
+	for (uint64_t minterm = 0; minterm < (UINT64_C(1) << VARIABLES_COUNT); minterm++) {
+		if ((boolean_benchmark_random_word(&state) & 3U) != 0) {
+			minterms.data[minterms.length++] = minterm;
+		}
+	}
+
+	double start = boolean_benchmark_seconds();
+	struct boolean_implicants implicants;
+	struct boolean_status status =
+		boolean_implicants_from_minterms(&minterms, &variables, NULL, NULL, &implicants);
+	double elapsed = boolean_benchmark_seconds() - start;
+	if (status.type == boolean_status_type_success) {
+		printf(
+			"%zu minterms %zu prime implicants %8.3f s\n",
+			minterms.length,
+			implicants.length,
+			elapsed
+		);
+		boolean_implicants_drop(&implicants);
+	} else {
+		boolean_status_print(&status);
+		boolean_status_drop(&status);
+	}
+
+	boolean_minterms_drop(&minterms);
+	boolean_variables_drop(&variables);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+#include "boolean_benchmark.h"
+
+#include <bool_tool/boolean_expression.h>
+#include <bool_tool/boolean_jit.h>
+#include <bool_tool/boolean_status.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ENVIRONMENTS_COUNT ((size_t)1 << 22)
+#define WORDS_COUNT (ENVIRONMENTS_COUNT / 64)
+
+static void report(const char *name, double elapsed, const uint64_t *results) {
+	size_t count = 0;
+	for (size_t i = 0; i < WORDS_COUNT; i++) {
+		count += (size_t)__builtin_popcountll(results[i]);
+	}
+	printf(
+		"%-12s %8.3f ms %10.1f M environments/s (%zu true)\n",
+		name,
+		elapsed * 1e3,
+		(double)ENVIRONMENTS_COUNT / elapsed / 1e6,
+		count
+	);
+}
+
+// compares the interpreter, the bit sliced interpreter and the compiled code on random
+// environments, taking the expression from the command line
+int main(int argc, char *argv[]) {
+	const char *string =
+		argc > 1 ? argv[1] : "(a * b + c' * d) ^ (e + f * g') * (h ^ a * c) + b' * d' * f";
+
+	struct boolean_expression expression;
+	struct boolean_status status = boolean_expression_from_string(string, &expression);
+	if (status.type != boolean_status_type_success) {
+		boolean_status_print(&status);
+		boolean_status_drop(&status);
+		return EXIT_FAILURE;
+	}
+
+	uint64_t *data = malloc(BOOLEAN_ENVIRONMENT_VARIABLES_COUNT * WORDS_COUNT * sizeof(*data));
+	uint64_t *results = malloc(WORDS_COUNT * sizeof(*results));
+	if (data == NULL || results == NULL) {
+		free(results);
+		free(data);
+		boolean_expression_drop(&expression);
+		return EXIT_FAILURE;
+	}
+
+	uint64_t state = UINT64_C(0x9E3779B97F4A7C15);
+	const uint64_t *columns[BOOLEAN_ENVIRONMENT_VARIABLES_COUNT];
+	for (size_t i = 0; i < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT; i++) {
+		columns[i] = &data[i * WORDS_COUNT];
+		for (size_t j = 0; j < WORDS_COUNT; j++) {
+			data[i * WORDS_COUNT + j] = boolean_benchmark_random_word(&state);
+		}
+	}
+
+	double start = boolean_benchmark_seconds();
+	for (size_t i = 0; i < WORDS_COUNT; i++) {
+		results[i] = 0;
+		for (size_t j = 0; j < 64; j++) {
+			struct boolean_environment environment = boolean_environment_new();
+			for (size_t k = 0; k < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT; k++) {
+				environment.variables |= ((columns[k][i] >> j) & 1U) << k;
+			}
+			results[i] |= (uint64_t)boolean_expression_evaluate(&expression, &environment) << j;
+		}
+	}
+	report("scalar", boolean_benchmark_seconds() - start, results);
+
+	start = boolean_benchmark_seconds();
+	boolean_expression_evaluate_batch(&expression, columns, ENVIRONMENTS_COUNT, results, false);
+	report("bit sliced", boolean_benchmark_seconds() - start, results);
+
+	struct boolean_jit jit = boolean_jit_new(&expression);
+	start = boolean_benchmark_seconds();
+	boolean_jit_evaluate(&jit, columns, ENVIRONMENTS_COUNT, results);
+	report(
+		boolean_jit_is_compiled(&jit) ? "compiled" : "interpreted",
+		boolean_benchmark_seconds() - start,
+		results
+	);
+	boolean_jit_drop(&jit);
+
+	free(results);
+	free(data);
+	boolean_expression_drop(&expression);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+#ifndef BOOLEAN_BDD_H
+#define BOOLEAN_BDD_H
+
+#include <bool_tool/boolean_budget.h>
+#include <bool_tool/boolean_expression.h>
+#include <bool_tool/boolean_status.h>
+#include <bool_tool/boolean_variables.h>
+#include <stdint.h>
+
+#define BOOLEAN_BDD_FALSE UINT32_C(0)
+#define BOOLEAN_BDD_TRUE UINT32_C(1)
+
+// a reduced ordered binary decision diagram, nodes are referred to by their index, and every
+// node comes after its children
+struct boolean_bdd {
+	struct boolean_bdd_node {
+		uint32_t level;
+		uint32_t low;
+		uint32_t high;
+	} *nodes;
+	size_t nodes_count;
+	size_t nodes_capacity;
+
+	// the unique table, chaining nodes with equal hashes
+	uint32_t *buckets;
+	uint32_t *chains;
+	size_t buckets_count;
+
+	struct boolean_bdd_cache_entry {
+		uint32_t operation;
+		uint32_t node_1;
+		uint32_t node_2;
+		uint32_t result;
+	} *cache;
+	size_t cache_count;
+
+	// the variable at each level, and the level of each variable
+	struct boolean_variables variables;
+	uint32_t levels[BOOLEAN_ENVIRONMENT_VARIABLES_COUNT];
+
+	// while the diagram is reordered in place, how many times each node is referred to, by other
+	// nodes or as the root, dead nodes being those referred to by none, and the nodes of each
+	// level, chained from the first, which may include dead ones
+	uint32_t *references;
+	uint32_t *level_chains;
+	uint32_t level_heads[BOOLEAN_ENVIRONMENT_VARIABLES_COUNT];
+	size_t live_nodes_count;
+
+	struct boolean_budget *budget;
+	size_t reserved_bytes;
+	// how many nodes have been looked up since the deadline was last checked
+	size_t steps;
+	bool exhausted;
+	bool expired;
+};
+
+void boolean_bdd_drop(struct boolean_bdd *bdd);
+struct boolean_bdd boolean_bdd_new(
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget
+);
+uint32_t boolean_bdd_variable(struct boolean_bdd *bdd, char name);
+uint32_t boolean_bdd_apply(
+	struct boolean_bdd *bdd,
+	enum boolean_operation_type type,
+	uint32_t node_1,
+	uint32_t node_2
+);
+struct boolean_status boolean_bdd_from_expression(
+	struct boolean_bdd *bdd,
+	const struct boolean_expression *expression,
+	uint32_t *node
+);
+void boolean_bdd_compact(struct boolean_bdd *bdd, uint32_t *node);
+bool boolean_bdd_reorder_begin(struct boolean_bdd *bdd, uint32_t *node);
+bool boolean_bdd_swap(struct boolean_bdd *bdd, uint32_t level);
+void boolean_bdd_reorder_end(struct boolean_bdd *bdd, uint32_t *node);
+size_t boolean_bdd_size(const struct boolean_bdd *bdd, uint32_t node);
+double boolean_bdd_probability(
+	const struct boolean_bdd *bdd,
+	uint32_t node,
+	const double *probabilities
+);
+
+#endif
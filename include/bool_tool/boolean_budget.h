@@ -0,0 +1,27 @@
+#ifndef BOOLEAN_BUDGET_H
+#define BOOLEAN_BUDGET_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// limits on the resources used by a computation, shared between the threads working on it
+struct boolean_budget {
+	size_t maximum_bytes;
+	size_t maximum_implicants;
+	double deadline;
+	atomic_size_t bytes;
+	atomic_size_t implicants;
+};
+
+struct boolean_budget boolean_budget_new(
+	size_t maximum_bytes,
+	size_t maximum_implicants,
+	double maximum_seconds
+);
+bool boolean_budget_reserve_bytes(struct boolean_budget *budget, size_t bytes);
+void boolean_budget_release_bytes(struct boolean_budget *budget, size_t bytes);
+bool boolean_budget_reserve_implicants(struct boolean_budget *budget, size_t implicants);
+bool boolean_budget_expired(const struct boolean_budget *budget);
+
+#endif
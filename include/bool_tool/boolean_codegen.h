@@ -0,0 +1,33 @@
+#ifndef BOOLEAN_CODEGEN_H
+#define BOOLEAN_CODEGEN_H
+
+#include <bool_tool/boolean_expression.h>
+#include <bool_tool/boolean_implicants.h>
+#include <bool_tool/boolean_variables.h>
+
+// how the generated function takes its inputs and computes its output, the scalar and lookup table
+// variants take the inputs packed like a minterm and return a bool, the bit sliced variant takes a
+// word per variable and returns a word of outputs
+enum boolean_codegen_variant {
+	boolean_codegen_variant_automatic,
+	boolean_codegen_variant_scalar,
+	boolean_codegen_variant_lookup_table,
+	boolean_codegen_variant_bit_sliced,
+};
+
+#define BOOLEAN_CODEGEN_LOOKUP_TABLE_VARIABLES_MAXIMUM 16
+
+char *boolean_expression_to_c(
+	const struct boolean_expression *expression,
+	const struct boolean_variables *variables,
+	const char *name,
+	enum boolean_codegen_variant variant
+);
+char *boolean_implicants_to_c(
+	const struct boolean_implicants *implicants,
+	const struct boolean_variables *variables,
+	const char *name,
+	enum boolean_codegen_variant variant
+);
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef BOOLEAN_ENUMERATION_H
+#define BOOLEAN_ENUMERATION_H
+
+#include <bool_tool/boolean_environment.h>
+#include <bool_tool/boolean_expression.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// an expression flattened so that its value over a word of rows can be updated as its variables
+// change one at a time, reevaluating only the operations above the occurrences of the variable
+// that changed, the values of its nodes are kept by the caller, so that threads can share it
+struct boolean_enumeration {
+	// the nodes in preorder, so that the operands of an operation come after it
+	struct boolean_enumeration_node {
+		enum boolean_expression_type type;
+		union {
+			bool value;
+			size_t index;
+			struct {
+				enum boolean_operation_type type;
+				uint32_t operands_offset;
+				uint32_t operands_count;
+			} operation;
+		};
+	} *nodes;
+	size_t nodes_count;
+	// the operands of every operation, as indices of nodes
+	uint32_t *operands;
+
+	// for each variable, by its index in the environment, the nodes where it occurs and the
+	// operations above them, from the last in preorder to the first
+	uint32_t *updates;
+	size_t updates_offsets[BOOLEAN_ENVIRONMENT_VARIABLES_COUNT + 1];
+};
+
+void boolean_enumeration_drop(struct boolean_enumeration *enumeration);
+struct boolean_enumeration boolean_enumeration_new(const struct boolean_expression *expression);
+void boolean_enumeration_evaluate(
+	const struct boolean_enumeration *enumeration,
+	const uint64_t *words,
+	uint64_t *values
+);
+void boolean_enumeration_flip(
+	const struct boolean_enumeration *enumeration,
+	size_t index,
+	uint64_t *values
+);
+
+#endif
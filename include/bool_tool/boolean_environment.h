@@ -2,12 +2,18 @@
 #define BOOLEAN_ENVIRONMENT_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#define BOOLEAN_ENVIRONMENT_VARIABLES_COUNT (('z' - 'a' + 1) + ('Z' - 'A' + 1))
+
 struct boolean_environment {
 	uint64_t variables;
 };
 
+size_t boolean_environment_variable_index(char name);
+char boolean_environment_variable_name(size_t index);
+
 struct boolean_environment boolean_environment_new(void);
 bool boolean_environment_get_variable(const struct boolean_environment *environment, char name);
 void boolean_environment_set_variable(
@@ -0,0 +1,29 @@
+#ifndef BOOLEAN_EQUIVALENCE_H
+#define BOOLEAN_EQUIVALENCE_H
+
+#include <bool_tool/boolean_budget.h>
+#include <bool_tool/boolean_expression.h>
+#include <bool_tool/boolean_status.h>
+#include <stdbool.h>
+
+struct boolean_status boolean_expression_is_satisfiable(
+	const struct boolean_expression *expression,
+	struct boolean_budget *budget,
+	bool *satisfiable,
+	struct boolean_environment *model
+);
+struct boolean_status boolean_expression_is_tautology(
+	const struct boolean_expression *expression,
+	struct boolean_budget *budget,
+	bool *tautology,
+	struct boolean_environment *counterexample
+);
+struct boolean_status boolean_expression_equivalent(
+	const struct boolean_expression *expression_1,
+	const struct boolean_expression *expression_2,
+	struct boolean_budget *budget,
+	bool *equivalent,
+	struct boolean_environment *counterexample
+);
+
+#endif
@@ -2,8 +2,13 @@
 #define BOOLEAN_EXPRESSION_H
 
 #include <bool_tool/boolean_environment.h>
+#include <bool_tool/boolean_status.h>
 #include <stddef.h>
 
+// the deepest expressions parsed, since dropping, cloning, printing, rewriting and evaluating them
+// recurses once per level
+#define BOOLEAN_EXPRESSION_DEPTH_MAXIMUM 1024
+
 struct boolean_expression {
 	enum boolean_expression_type {
 		boolean_expression_type_constant,
@@ -21,9 +26,11 @@ struct boolean_expression {
 			enum boolean_operation_type {
 				boolean_operation_type_conjunction,
 				boolean_operation_type_disjunction,
+				boolean_operation_type_exclusive_disjunction,
 				boolean_operation_type_negation,
 			} type;
 			struct boolean_expression *operands;
+			size_t operands_count;
 		} operation;
 	};
 };
@@ -35,8 +42,20 @@ void boolean_expression_drop(struct boolean_expression *expression);
 struct boolean_expression boolean_expression_new_constant(bool value);
 struct boolean_expression boolean_expression_new_variable(char name);
 struct boolean_expression boolean_expression_new_operation(enum boolean_operation_type type, ...);
+struct boolean_expression boolean_expression_new_operation_from_operands(
+	enum boolean_operation_type type,
+	struct boolean_expression *operands,
+	size_t operands_count
+);
 struct boolean_expression boolean_expression_clone(const struct boolean_expression *expression);
-struct boolean_expression boolean_expression_from_string(const char *string);
+int boolean_expression_compare(
+	const struct boolean_expression *expression_1,
+	const struct boolean_expression *expression_2
+);
+struct boolean_status boolean_expression_from_string(
+	const char *string,
+	struct boolean_expression *expression
+);
 char *boolean_expression_to_string(const struct boolean_expression *expression);
 struct boolean_minterms;
 struct boolean_variables;
@@ -44,14 +63,45 @@ struct boolean_expression boolean_expression_from_minterms(
 	const struct boolean_minterms *minterms,
 	const struct boolean_variables *variables
 );
+struct boolean_implicant;
+struct boolean_expression boolean_expression_from_implicant(
+	struct boolean_implicant implicant,
+	const struct boolean_variables *variables
+);
 struct boolean_implicants;
 struct boolean_expression boolean_expression_from_implicants(
 	const struct boolean_implicants *implicants,
 	const struct boolean_variables *variables
 );
+struct boolean_shared_implicants;
+struct boolean_expression boolean_expression_from_shared_implicants(
+	const struct boolean_shared_implicants *implicants,
+	size_t output,
+	const struct boolean_variables *variables
+);
+struct boolean_expression boolean_expression_product_of_sums_from_implicants(
+	const struct boolean_implicants *implicants,
+	const struct boolean_variables *variables
+);
+struct boolean_expression boolean_expression_exclusive_sum_of_products_from_minterms(
+	const struct boolean_minterms *minterms,
+	const struct boolean_variables *variables
+);
+size_t boolean_expression_cost(const struct boolean_expression *expression);
 bool boolean_expression_evaluate(
 	const struct boolean_expression *expression,
 	const struct boolean_environment *environment
 );
+uint64_t boolean_expression_evaluate_word(
+	const struct boolean_expression *expression,
+	const uint64_t *words
+);
+void boolean_expression_evaluate_batch(
+	const struct boolean_expression *expression,
+	const uint64_t *const *columns,
+	size_t environments_count,
+	uint64_t *results,
+	bool parallel
+);
 
 #endif
@@ -0,0 +1,22 @@
+#ifndef BOOLEAN_FACTORING_H
+#define BOOLEAN_FACTORING_H
+
+#include <bool_tool/boolean_budget.h>
+#include <bool_tool/boolean_expression.h>
+#include <bool_tool/boolean_implicants.h>
+#include <bool_tool/boolean_variables.h>
+
+// the literals of a sum of products, and of the expression it's factored into
+struct boolean_factoring_costs {
+	size_t sum_of_products;
+	size_t factored;
+};
+
+struct boolean_expression boolean_expression_factored_from_implicants(
+	const struct boolean_implicants *implicants,
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget,
+	struct boolean_factoring_costs *costs
+);
+
+#endif
@@ -1,7 +1,9 @@
 #ifndef BOOLEAN_FUNCTION_H
 #define BOOLEAN_FUNCTION_H
 
+#include <bool_tool/boolean_bdd.h>
 #include <bool_tool/boolean_expression.h>
+#include <bool_tool/boolean_implicants.h>
 #include <bool_tool/boolean_minterms.h>
 #include <bool_tool/boolean_variables.h>
 
@@ -17,6 +19,38 @@ struct boolean_function {
 			struct boolean_variables variables;
 		};
 	};
+
+	// the forms derived from the representation, each computed the first time it's asked for, and
+	// kept until the function is dropped
+	struct boolean_function_cache {
+		bool variables_cached;
+		bool minterms_cached;
+		bool truth_table_cached;
+		bool prime_implicants_cached;
+		bool minimal_implicants_cached;
+		bool bdd_cached;
+
+		// only derived for an expression, as minterms come with their variables
+		struct boolean_variables variables;
+		struct boolean_minterms minterms;
+		// the value on row r is bit r % 64 of word r / 64, rows being packed like minterms
+		uint64_t *truth_table;
+		struct boolean_implicants prime_implicants;
+		struct boolean_implicants minimal_implicants;
+		struct boolean_bdd bdd;
+		uint32_t bdd_node;
+	} cache;
+};
+
+// state kept between simplifications, such as while the function is being typed, so that
+// simplifying functions of similar size reuses the buffers of the previous ones
+struct boolean_simplifier {
+	// for the sum of products and the product of sums, which are found in parallel
+	struct boolean_implicants_workspace workspaces[2];
+	// for the groups of operands with disjoint supports an expression splits into, which are
+	// simplified in parallel
+	struct boolean_simplifier *components;
+	size_t components_count;
 };
 
 void boolean_function_drop(struct boolean_function *function);
@@ -26,5 +60,59 @@ struct boolean_function boolean_function_new_minterms(
 	struct boolean_variables variables
 );
 struct boolean_function boolean_function_clone(const struct boolean_function *function);
+const struct boolean_variables *boolean_function_variables(struct boolean_function *function);
+struct boolean_status boolean_function_minterms(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	const struct boolean_minterms **minterms
+);
+struct boolean_status boolean_function_truth_table(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	const uint64_t **truth_table
+);
+struct boolean_status boolean_function_prime_implicants(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	const struct boolean_implicants **implicants
+);
+struct boolean_status boolean_function_minimal_implicants(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	const struct boolean_implicants **implicants
+);
+struct boolean_status boolean_function_bdd(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	const struct boolean_bdd **bdd,
+	uint32_t *node
+);
+struct boolean_status boolean_function_simplify(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	struct boolean_expression *expression
+);
+void boolean_simplifier_drop(struct boolean_simplifier *simplifier);
+struct boolean_simplifier boolean_simplifier_new(void);
+struct boolean_status boolean_simplifier_simplify(
+	struct boolean_simplifier *simplifier,
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	struct boolean_expression *expression
+);
+struct boolean_status boolean_function_simplify_outputs(
+	const struct boolean_minterms *minterms,
+	size_t outputs_count,
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget,
+	struct boolean_expression *expressions
+);
+struct boolean_status boolean_function_simplify_batch(
+	const struct boolean_minterms *minterms,
+	size_t functions_count,
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget,
+	struct boolean_expression *expressions
+);
 
 #endif
@@ -9,7 +9,10 @@ G_BEGIN_DECLS
 #define BOOLEAN_FUNCTION_INPUT_TYPE boolean_function_input_get_type()
 G_DECLARE_FINAL_TYPE(BooleanFunctionInput, boolean_function_input, BOOLEAN_FUNCTION, INPUT, GtkBox)
 
-struct boolean_function boolean_function_input_get_function(const BooleanFunctionInput *self);
+struct boolean_status boolean_function_input_get_function(
+	const BooleanFunctionInput *self,
+	struct boolean_function *function
+);
 
 G_END_DECLS
 
@@ -12,15 +12,62 @@ struct boolean_implicants {
 	size_t capacity;
 };
 
+struct boolean_shared_implicants {
+	struct boolean_shared_implicant {
+		struct boolean_implicant implicant;
+		uint64_t outputs;
+	} *data;
+	size_t length;
+	size_t capacity;
+};
+
+// buffers kept between runs of finding and covering implicants, so that repeated runs stop
+// allocating once they've grown large enough, a run can also be given none
+struct boolean_implicants_workspace {
+	// the two tables the Quine-McCluskey method alternates between, by the terms each can hold
+	struct boolean_implicants_table_storage {
+		void *data;
+		size_t capacity;
+	} tables[2];
+	// the scratch of the covering
+	void *cover;
+	size_t cover_bytes;
+};
+
 void boolean_implicants_drop(struct boolean_implicants *implicants);
 struct boolean_implicants boolean_implicants_new(void);
-struct boolean_implicants boolean_implicants_from_minterms(
+struct boolean_status boolean_implicants_from_minterms(
 	const struct boolean_minterms *minterms,
-	const struct boolean_variables *variables
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget,
+	struct boolean_implicants_workspace *workspace,
+	struct boolean_implicants *implicants
 );
-void boolean_implicants_minimalize(
+struct boolean_status boolean_implicants_minimalize(
 	struct boolean_implicants *implicants,
-	const struct boolean_minterms *minterms
+	const struct boolean_minterms *minterms,
+	struct boolean_budget *budget,
+	struct boolean_implicants_workspace *workspace
+);
+
+void boolean_implicants_workspace_drop(struct boolean_implicants_workspace *workspace);
+struct boolean_implicants_workspace boolean_implicants_workspace_new(void);
+
+void boolean_shared_implicants_drop(struct boolean_shared_implicants *implicants);
+struct boolean_shared_implicants boolean_shared_implicants_new(void);
+struct boolean_status boolean_shared_implicants_from_minterms(
+	const struct boolean_minterms *minterms,
+	size_t outputs_count,
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget,
+	struct boolean_implicants_workspace *workspace,
+	struct boolean_shared_implicants *implicants
+);
+struct boolean_status boolean_shared_implicants_minimalize(
+	struct boolean_shared_implicants *implicants,
+	const struct boolean_minterms *minterms,
+	size_t outputs_count,
+	struct boolean_budget *budget
 );
 
 #endif
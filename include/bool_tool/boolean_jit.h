@@ -0,0 +1,28 @@
+#ifndef BOOLEAN_JIT_H
+#define BOOLEAN_JIT_H
+
+#include <bool_tool/boolean_expression.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// an expression compiled to native code evaluating it over bit sliced environments, or, where
+// that isn't supported, the expression itself, evaluated by the interpreter
+struct boolean_jit {
+	void (*function)(const uint64_t *const *columns, uint64_t *results, size_t words_count);
+	void *code;
+	size_t code_size;
+	struct boolean_expression expression;
+	struct boolean_environment support;
+};
+
+void boolean_jit_drop(struct boolean_jit *jit);
+struct boolean_jit boolean_jit_new(const struct boolean_expression *expression);
+bool boolean_jit_is_compiled(const struct boolean_jit *jit);
+void boolean_jit_evaluate(
+	const struct boolean_jit *jit,
+	const uint64_t *const *columns,
+	size_t environments_count,
+	uint64_t *results
+);
+
+#endif
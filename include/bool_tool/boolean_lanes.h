@@ -0,0 +1,34 @@
+#ifndef BOOLEAN_LANES_H
+#define BOOLEAN_LANES_H
+
+#include <bool_tool/boolean_environment.h>
+#include <bool_tool/boolean_expression.h>
+#include <bool_tool/boolean_variables.h>
+
+// the low bits of a row index pick its lane within a word of rows, the rest pick the word
+#define BOOLEAN_LANE_VARIABLES_COUNT 6
+
+// the variables of a truth table set up to evaluate an expression a word of rows at a time, the
+// variables of the first bits of the row index vary within a word, the rest between words
+struct boolean_lanes {
+	// the index in the environment of the variable of each bit of the row index
+	size_t indices[BOOLEAN_ENVIRONMENT_VARIABLES_COUNT];
+	size_t variables_count;
+	size_t lane_variables_count;
+	// the lanes of a word that are rows, all of them unless there are fewer than 6 variables
+	uint64_t lanes_mask;
+	// the value of each variable over the rows of the current word, by its index in the environment
+	uint64_t words[BOOLEAN_ENVIRONMENT_VARIABLES_COUNT];
+};
+
+struct boolean_lanes boolean_lanes_from_support(const struct boolean_environment *support);
+struct boolean_lanes boolean_lanes_from_variables(const struct boolean_variables *variables);
+uint64_t boolean_lanes_words_count(const struct boolean_lanes *lanes);
+void boolean_lanes_set_word(struct boolean_lanes *lanes, uint64_t word);
+uint64_t boolean_lanes_evaluate(
+	struct boolean_lanes *lanes,
+	const struct boolean_expression *expression,
+	uint64_t word
+);
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef BOOLEAN_MINTERM_SET_H
+#define BOOLEAN_MINTERM_SET_H
+
+#include <bool_tool/boolean_minterms.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// the number of minterms a container spans, and the most a container stores as a sorted array
+#define BOOLEAN_MINTERM_CONTAINER_SPAN (UINT64_C(1) << 16)
+#define BOOLEAN_MINTERM_CONTAINER_ARRAY_MAXIMUM 4096
+
+// a set of minterms, split into containers of consecutive minterms that are stored as sorted
+// arrays while sparse and as bitsets once dense
+struct boolean_minterm_set {
+	struct boolean_minterm_container {
+		uint64_t key;
+		size_t length;
+		enum boolean_minterm_container_representation {
+			boolean_minterm_container_representation_array,
+			boolean_minterm_container_representation_bitset,
+		} representation;
+		union {
+			struct {
+				uint16_t *data;
+				size_t capacity;
+			} array;
+			uint64_t *bitset;
+		};
+	} *containers;
+	size_t containers_count;
+	size_t containers_capacity;
+};
+
+void boolean_minterm_set_drop(struct boolean_minterm_set *set);
+struct boolean_minterm_set boolean_minterm_set_new(void);
+struct boolean_minterm_set boolean_minterm_set_from_minterms(const struct boolean_minterms *minterms
+);
+size_t boolean_minterm_set_length(const struct boolean_minterm_set *set);
+bool boolean_minterm_set_add(struct boolean_minterm_set *set, uint64_t minterm);
+struct boolean_minterm_set boolean_minterm_set_complement(
+	const struct boolean_minterm_set *set,
+	size_t variables_count
+);
+
+struct boolean_minterms boolean_minterms_from_set(const struct boolean_minterm_set *set);
+
+#endif
@@ -1,8 +1,10 @@
 #ifndef BOOLEAN_MINTERMS_H
 #define BOOLEAN_MINTERMS_H
 
+#include <bool_tool/boolean_budget.h>
 #include <bool_tool/boolean_expression.h>
 
+// minterms in increasing order, without repeats
 struct boolean_minterms {
 	uint64_t *data;
 	size_t length;
@@ -12,7 +14,24 @@ void boolean_minterms_drop(struct boolean_minterms *minterms);
 struct boolean_minterms boolean_minterms_clone(const struct boolean_minterms *minterms);
 struct boolean_minterms boolean_minterms_from_string(const char *string);
 char *boolean_minterms_to_string(const struct boolean_minterms *minterms);
-struct boolean_minterms boolean_minterms_from_expression(const struct boolean_expression *expression
+struct boolean_minterms boolean_minterms_complement(
+	const struct boolean_minterms *minterms,
+	size_t variables_count
+);
+size_t boolean_minterms_find(const struct boolean_minterms *minterms, uint64_t minterm);
+struct boolean_status boolean_truth_table_from_expression(
+	const struct boolean_expression *expression,
+	struct boolean_budget *budget,
+	uint64_t **truth_table
+);
+struct boolean_minterms boolean_minterms_from_truth_table(
+	const uint64_t *truth_table,
+	size_t variables_count
+);
+struct boolean_status boolean_minterms_from_expression(
+	const struct boolean_expression *expression,
+	struct boolean_budget *budget,
+	struct boolean_minterms *minterms
 );
 
 #endif
@@ -0,0 +1,42 @@
+#ifndef BOOLEAN_NPN_H
+#define BOOLEAN_NPN_H
+
+#include <bool_tool/boolean_expression.h>
+#include <bool_tool/boolean_variables.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BOOLEAN_NPN_VARIABLES_MAXIMUM 16
+
+// how a function is read from another one, bit i of a row of the function is bit permutation[i] of
+// a row of the other one, flipped if bit i of the input negations is set, and the function's value
+// is the other one's, flipped if the output is negated
+struct boolean_npn_transform {
+	uint8_t permutation[BOOLEAN_NPN_VARIABLES_MAXIMUM];
+	uint32_t input_negations;
+	bool output_negation;
+};
+
+// truth tables hold the value on row r in bit r % 64 of word r / 64, rows being packed like
+// minterms
+size_t boolean_npn_words_count(size_t variables_count);
+void boolean_npn_apply(
+	const uint64_t *truth_table,
+	size_t variables_count,
+	const struct boolean_npn_transform *transform,
+	uint64_t *result
+);
+void boolean_npn_canonicalize(
+	const uint64_t *truth_table,
+	size_t variables_count,
+	uint64_t *canonical,
+	struct boolean_npn_transform *transform
+);
+struct boolean_expression boolean_expression_from_npn(
+	const struct boolean_expression *expression,
+	const struct boolean_variables *variables,
+	const struct boolean_npn_transform *transform
+);
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef BOOLEAN_ORDERING_H
+#define BOOLEAN_ORDERING_H
+
+#include <bool_tool/boolean_bdd.h>
+#include <bool_tool/boolean_budget.h>
+#include <bool_tool/boolean_expression.h>
+#include <bool_tool/boolean_status.h>
+#include <bool_tool/boolean_variables.h>
+
+struct boolean_variables boolean_variables_order_from_expression(
+	const struct boolean_expression *expression
+);
+struct boolean_status boolean_bdd_sift(
+	struct boolean_bdd *bdd,
+	uint32_t *node,
+	struct boolean_budget *budget
+);
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef BOOLEAN_PARALLEL_H
+#define BOOLEAN_PARALLEL_H
+
+#include <stddef.h>
+
+size_t boolean_parallel_threads_count(void);
+void boolean_parallel_for(
+	size_t count,
+	void (*function)(size_t index, void *context),
+	void *context
+);
+
+#endif
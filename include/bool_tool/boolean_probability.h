@@ -0,0 +1,21 @@
+#ifndef BOOLEAN_PROBABILITY_H
+#define BOOLEAN_PROBABILITY_H
+
+#include <bool_tool/boolean_budget.h>
+#include <bool_tool/boolean_expression.h>
+#include <bool_tool/boolean_status.h>
+#include <stdint.h>
+
+struct boolean_status boolean_expression_count_models(
+	const struct boolean_expression *expression,
+	struct boolean_budget *budget,
+	uint64_t *count
+);
+struct boolean_status boolean_expression_probability(
+	const struct boolean_expression *expression,
+	const double *probabilities,
+	struct boolean_budget *budget,
+	double *probability
+);
+
+#endif
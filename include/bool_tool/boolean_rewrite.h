@@ -0,0 +1,9 @@
+#ifndef BOOLEAN_REWRITE_H
+#define BOOLEAN_REWRITE_H
+
+#include <bool_tool/boolean_expression.h>
+
+void boolean_expression_rewrite(struct boolean_expression *expression);
+bool boolean_expression_is_read_once_sum_of_products(const struct boolean_expression *expression);
+
+#endif
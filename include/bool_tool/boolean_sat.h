@@ -0,0 +1,74 @@
+#ifndef BOOLEAN_SAT_H
+#define BOOLEAN_SAT_H
+
+#include <bool_tool/boolean_budget.h>
+#include <bool_tool/boolean_expression.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// a conflict-driven clause learning solver, literals are nonzero integers whose magnitude is the
+// variable, counting from 1, and whose sign is the polarity
+struct boolean_sat {
+	size_t variables_count;
+	size_t variables_capacity;
+
+	// clauses are stored one after the other, each as its length followed by its literals
+	struct boolean_sat_clauses {
+		uint32_t *data;
+		size_t length;
+		size_t capacity;
+	} clauses;
+	struct boolean_sat_watches {
+		size_t *data;
+		size_t length;
+		size_t capacity;
+	} *watches;
+
+	int8_t *values;
+	bool *phases;
+	bool *model;
+	bool *seen;
+	size_t *levels;
+	size_t *reasons;
+
+	uint32_t *trail;
+	size_t trail_length;
+	size_t *trail_limits;
+	size_t level;
+	size_t propagated;
+
+	double *activities;
+	double activity_increment;
+	size_t *heap;
+	size_t heap_length;
+	size_t *heap_positions;
+
+	int true_literal;
+	bool inconsistent;
+};
+
+enum boolean_sat_result {
+	boolean_sat_result_satisfiable,
+	boolean_sat_result_unsatisfiable,
+	boolean_sat_result_unknown,
+};
+
+void boolean_sat_drop(struct boolean_sat *sat);
+struct boolean_sat boolean_sat_new(void);
+int boolean_sat_new_variable(struct boolean_sat *sat);
+void boolean_sat_add_clause(struct boolean_sat *sat, const int *literals, size_t literals_count);
+int boolean_sat_add_expression(
+	struct boolean_sat *sat,
+	const struct boolean_expression *expression,
+	int *variables
+);
+enum boolean_sat_result boolean_sat_solve(
+	struct boolean_sat *sat,
+	const int *assumptions,
+	size_t assumptions_count,
+	struct boolean_budget *budget
+);
+bool boolean_sat_value(const struct boolean_sat *sat, int literal);
+
+#endif
@@ -21,6 +21,7 @@ struct boolean_status boolean_status_success(void);
 struct boolean_status boolean_status_failure(const char *format, ...)
 	__attribute__((__format__(__printf__, 1, 2)));
 void boolean_status_drop(struct boolean_status *self);
+const char *boolean_status_message(const struct boolean_status *self);
 void boolean_status_print(const struct boolean_status *self);
 
 #endif
@@ -0,0 +1,30 @@
+#ifndef BOOLEAN_TRUTH_TABLE_VIEW_H
+#define BOOLEAN_TRUTH_TABLE_VIEW_H
+
+#include <bool_tool/boolean_function.h>
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+// the most variables whose truth table is shown, and whose karnaugh map is
+#define BOOLEAN_TRUTH_TABLE_VIEW_VARIABLES_MAXIMUM 28
+#define BOOLEAN_TRUTH_TABLE_VIEW_KARNAUGH_MAP_VARIABLES_MAXIMUM 16
+
+#define BOOLEAN_TRUTH_TABLE_VIEW_TYPE boolean_truth_table_view_get_type()
+G_DECLARE_FINAL_TYPE(
+	BooleanTruthTableView,
+	boolean_truth_table_view,
+	BOOLEAN_TRUTH_TABLE,
+	VIEW,
+	GtkBox
+)
+
+void boolean_truth_table_view_set_function(
+	BooleanTruthTableView *self,
+	struct boolean_function function
+);
+void boolean_truth_table_view_clear(BooleanTruthTableView *self);
+
+G_END_DECLS
+
+#endif
@@ -12,6 +12,10 @@ void boolean_variables_drop(struct boolean_variables *variables);
 struct boolean_variables boolean_variables_clone(const struct boolean_variables *variables);
 struct boolean_variables boolean_variables_from_string(const char *string);
 char *boolean_variables_to_string(const struct boolean_variables *variables);
+void boolean_variables_from_expression_(
+	const struct boolean_expression *expression,
+	struct boolean_environment *environment
+);
 struct boolean_variables boolean_variables_from_expression(
 	const struct boolean_expression *expression
 );
@@ -2,6 +2,7 @@
 
 #include <bool_tool/application_window.h>
 #include <bool_tool/boolean_function_input.h>
+#include <bool_tool/boolean_truth_table_view.h>
 #include <glib-object.h>
 
 struct _BoolToolApplication {
@@ -21,6 +22,7 @@ static void remove_style_provider(gpointer data) {
 
 static void bool_tool_application_activate(GApplication *application) {
 	g_type_ensure(BOOLEAN_FUNCTION_INPUT_TYPE);
+	g_type_ensure(BOOLEAN_TRUTH_TABLE_VIEW_TYPE);
 	g_type_ensure(BOOL_TOOL_APPLICATION_WINDOW_TYPE);
 
 	BoolToolApplicationWindow *window =
@@ -2,15 +2,24 @@
 #include <bool_tool/application_window.h>
 
 #include <bool_tool/boolean_function_input.h>
-#include <bool_tool/boolean_implicants.h>
+#include <bool_tool/boolean_truth_table_view.h>
 #include <gtk/gtk.h>
 
 struct _BoolToolApplicationWindow {
 	GtkApplicationWindow parent;
 	BooleanFunctionInput *input;
 	GtkLabel *output_label;
+	BooleanTruthTableView *truth_table_view;
+
+	// kept between simplifications, so repeated ones reuse its buffers
+	struct boolean_simplifier simplifier;
 };
 
+// the limits simplification runs under, past which it settles for a less simplified expression
+#define SIMPLIFY_MAXIMUM_BYTES ((size_t)1 << 30)
+#define SIMPLIFY_MAXIMUM_IMPLICANTS ((size_t)1 << 20)
+#define SIMPLIFY_MAXIMUM_SECONDS 10.0
+
 G_DEFINE_TYPE(BoolToolApplicationWindow, bool_tool_application_window, GTK_TYPE_APPLICATION_WINDOW)
 
 static void bool_tool_application_window_dispose(GObject *gobject) {
@@ -19,8 +28,17 @@ static void bool_tool_application_window_dispose(GObject *gobject) {
 	G_OBJECT_CLASS(bool_tool_application_window_parent_class)->dispose(gobject);
 }
 
+static void bool_tool_application_window_finalize(GObject *gobject) {
+	BoolToolApplicationWindow *self = BOOL_TOOL_APPLICATION_WINDOW(gobject);
+
+	boolean_simplifier_drop(&self->simplifier);
+
+	G_OBJECT_CLASS(bool_tool_application_window_parent_class)->finalize(gobject);
+}
+
 static void bool_tool_application_window_class_init(BoolToolApplicationWindowClass *class) {
 	G_OBJECT_CLASS(class)->dispose = bool_tool_application_window_dispose;
+	G_OBJECT_CLASS(class)->finalize = bool_tool_application_window_finalize;
 
 	GtkWidgetClass *widget_class = GTK_WIDGET_CLASS(class);
 
@@ -31,10 +49,17 @@ static void bool_tool_application_window_class_init(BoolToolApplicationWindowCla
 
 	gtk_widget_class_bind_template_child(widget_class, BoolToolApplicationWindow, input);
 	gtk_widget_class_bind_template_child(widget_class, BoolToolApplicationWindow, output_label);
+	gtk_widget_class_bind_template_child(
+		widget_class,
+		BoolToolApplicationWindow,
+		truth_table_view
+	);
 }
 
 static void bool_tool_application_window_init(BoolToolApplicationWindow *self) {
 	gtk_widget_init_template(GTK_WIDGET(self));
+
+	self->simplifier = boolean_simplifier_new();
 }
 
 BoolToolApplicationWindow *bool_tool_application_window_new(BoolToolApplication *application) {
@@ -48,37 +73,38 @@ void simplify_button_clicked(GtkButton *self, gpointer user_data) {
 		gtk_widget_get_ancestor(GTK_WIDGET(self), BOOL_TOOL_APPLICATION_WINDOW_TYPE)
 	);
 
-	struct boolean_function function = boolean_function_input_get_function(window->input);
-
-	struct boolean_minterms minterms;
-	struct boolean_variables variables;
-	switch (function.representation) {
-		case boolean_function_representation_expression: {
-			minterms = boolean_minterms_from_expression(&function.expression);
-			variables = boolean_variables_from_expression(&function.expression);
-			boolean_expression_drop(&function.expression);
-		} break;
-		case boolean_function_representation_minterms: {
-			minterms = function.minterms;
-			variables = function.variables;
-		} break;
+	struct boolean_function function;
+	struct boolean_status status = boolean_function_input_get_function(window->input, &function);
+	if (status.type != boolean_status_type_success) {
+		gtk_label_set_text(window->output_label, boolean_status_message(&status));
+		boolean_status_drop(&status);
+		boolean_truth_table_view_clear(window->truth_table_view);
+		return;
 	}
 
-	struct boolean_implicants implicants = boolean_implicants_from_minterms(&minterms, &variables);
-
-	boolean_implicants_minimalize(&implicants, &minterms);
-	boolean_minterms_drop(&minterms);
-
-	struct boolean_expression expression =
-		boolean_expression_from_implicants(&implicants, &variables);
-	boolean_implicants_drop(&implicants);
-	boolean_variables_drop(&variables);
+	struct boolean_budget budget = boolean_budget_new(
+		SIMPLIFY_MAXIMUM_BYTES,
+		SIMPLIFY_MAXIMUM_IMPLICANTS,
+		SIMPLIFY_MAXIMUM_SECONDS
+	);
+	struct boolean_expression expression;
+	status = boolean_simplifier_simplify(&window->simplifier, &function, &budget, &expression);
+	if (status.type != boolean_status_type_success) {
+		gtk_label_set_text(window->output_label, boolean_status_message(&status));
+		boolean_status_drop(&status);
+		boolean_truth_table_view_clear(window->truth_table_view);
+		boolean_function_drop(&function);
+		return;
+	}
 
 	char *expression_string = boolean_expression_to_string(&expression);
 	gtk_label_set_text(window->output_label, expression_string);
 	free(expression_string);
 
 	boolean_expression_drop(&expression);
+
+	// the view takes the function, along with what simplifying it left in its cache
+	boolean_truth_table_view_set_function(window->truth_table_view, function);
 }
 
 void input_changed(BooleanFunctionInput *self, gpointer user_data) {
@@ -89,6 +115,7 @@ void input_changed(BooleanFunctionInput *self, gpointer user_data) {
 	);
 
 	gtk_label_set_text(window->output_label, "");
+	boolean_truth_table_view_clear(window->truth_table_view);
 
 	g_print("TEST!\n");
 }
@@ -0,0 +1,703 @@
+#include <bool_tool/boolean_bdd.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_NODE UINT32_MAX
+
+// the smallest the unique table and the operation cache get
+#define BUCKETS_MINIMUM ((size_t)1 << 10)
+#define CACHE_MINIMUM ((size_t)1 << 12)
+
+// how many nodes are looked up between checks of the deadline
+#define DEADLINE_CHECK_INTERVAL 4096
+
+static size_t boolean_bdd_hash(uint32_t level, uint32_t low, uint32_t high) {
+	uint64_t hash = level;
+	hash = hash * UINT64_C(0x9E3779B97F4A7C15) + low;
+	hash = hash * UINT64_C(0x9E3779B97F4A7C15) + high;
+	return (size_t)(hash ^ (hash >> 29));
+}
+
+// accounts the change in memory against the budget
+static bool boolean_bdd_reserve(struct boolean_bdd *bdd, size_t bytes) {
+	if (!boolean_budget_reserve_bytes(bdd->budget, bytes)) {
+		return false;
+	}
+	bdd->reserved_bytes += bytes;
+	return true;
+}
+
+static void boolean_bdd_chain(struct boolean_bdd *bdd, uint32_t index) {
+	const struct boolean_bdd_node *node = &bdd->nodes[index];
+	size_t bucket = boolean_bdd_hash(node->level, node->low, node->high) & (bdd->buckets_count - 1);
+	bdd->chains[index] = bdd->buckets[bucket];
+	bdd->buckets[bucket] = index;
+}
+// takes the node out of the unique table, before its level or children change
+static void boolean_bdd_unchain(struct boolean_bdd *bdd, uint32_t index) {
+	const struct boolean_bdd_node *node = &bdd->nodes[index];
+	size_t bucket = boolean_bdd_hash(node->level, node->low, node->high) & (bdd->buckets_count - 1);
+	uint32_t *link = &bdd->buckets[bucket];
+	while (*link != index) {
+		assert(*link != NO_NODE);
+		link = &bdd->chains[*link];
+	}
+	*link = bdd->chains[index];
+}
+
+static void boolean_bdd_rehash(struct boolean_bdd *bdd, size_t buckets_count) {
+	free(bdd->buckets);
+	bdd->buckets = malloc(buckets_count * sizeof(*bdd->buckets));
+	assert(bdd->buckets != NULL);
+	bdd->buckets_count = buckets_count;
+
+	for (size_t i = 0; i < buckets_count; i++) {
+		bdd->buckets[i] = NO_NODE;
+	}
+	for (uint32_t i = 2; i < bdd->nodes_count; i++) {
+		if (bdd->references == NULL || bdd->references[i] != 0) {
+			boolean_bdd_chain(bdd, i);
+		}
+	}
+}
+
+static void boolean_bdd_resize_cache(struct boolean_bdd *bdd, size_t cache_count) {
+	free(bdd->cache);
+	bdd->cache = malloc(cache_count * sizeof(*bdd->cache));
+	assert(bdd->cache != NULL);
+	bdd->cache_count = cache_count;
+
+	for (size_t i = 0; i < cache_count; i++) {
+		bdd->cache[i].operation = NO_NODE;
+	}
+}
+
+void boolean_bdd_drop(struct boolean_bdd *bdd) {
+	assert(bdd != NULL);
+
+	free(bdd->nodes);
+	free(bdd->buckets);
+	free(bdd->chains);
+	free(bdd->cache);
+	free(bdd->references);
+	free(bdd->level_chains);
+	boolean_variables_drop(&bdd->variables);
+	boolean_budget_release_bytes(bdd->budget, bdd->reserved_bytes);
+}
+
+// the variables are ordered from the root down
+struct boolean_bdd boolean_bdd_new(
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget
+) {
+	assert(variables != NULL && variables->length <= BOOLEAN_ENVIRONMENT_VARIABLES_COUNT);
+
+	struct boolean_bdd bdd = {
+		.nodes = malloc(2 * sizeof(*bdd.nodes)),
+		.nodes_count = 2,
+		.nodes_capacity = 2,
+		.buckets = NULL,
+		.chains = malloc(2 * sizeof(*bdd.chains)),
+		.buckets_count = 0,
+		.cache = NULL,
+		.cache_count = 0,
+		.variables = boolean_variables_clone(variables),
+		.references = NULL,
+		.level_chains = NULL,
+		.live_nodes_count = 0,
+		.budget = budget,
+		.reserved_bytes = 0,
+		.steps = 0,
+		.exhausted = false,
+		.expired = false,
+	};
+	assert(bdd.nodes != NULL && bdd.chains != NULL);
+
+	for (size_t i = 0; i < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT; i++) {
+		bdd.levels[i] = NO_NODE;
+	}
+	for (size_t i = 0; i < variables->length; i++) {
+		bdd.levels[boolean_environment_variable_index(variables->data[i])] = (uint32_t)i;
+	}
+
+	// the terminals sit below every variable
+	uint32_t terminal_level = (uint32_t)variables->length;
+	bdd.nodes[BOOLEAN_BDD_FALSE] = (struct boolean_bdd_node){ terminal_level, 0, 0 };
+	bdd.nodes[BOOLEAN_BDD_TRUE] = (struct boolean_bdd_node){ terminal_level, 1, 1 };
+
+	boolean_bdd_rehash(&bdd, BUCKETS_MINIMUM);
+	boolean_bdd_resize_cache(&bdd, CACHE_MINIMUM);
+
+	return bdd;
+}
+
+// doubles the nodes the diagram can hold, returns false if that would exceed the budget, or the
+// numbers nodes can be referred to by
+static bool boolean_bdd_grow(struct boolean_bdd *bdd) {
+	if (bdd->nodes_capacity >= NO_NODE / 2) {
+		return false;
+	}
+
+	size_t capacity = bdd->nodes_capacity * 2;
+	size_t node_size = sizeof(*bdd->nodes) + sizeof(*bdd->chains);
+	if (bdd->references != NULL) {
+		node_size += sizeof(*bdd->references) + sizeof(*bdd->level_chains);
+	}
+	size_t bytes = (capacity - bdd->nodes_capacity) * node_size;
+	// the table and the cache are kept as large as the nodes
+	if (capacity > bdd->buckets_count) {
+		bytes += capacity * sizeof(*bdd->buckets) + capacity * sizeof(*bdd->cache);
+	}
+	if (!boolean_bdd_reserve(bdd, bytes)) {
+		return false;
+	}
+
+	bdd->nodes = realloc(bdd->nodes, capacity * sizeof(*bdd->nodes));
+	bdd->chains = realloc(bdd->chains, capacity * sizeof(*bdd->chains));
+	assert(bdd->nodes != NULL && bdd->chains != NULL);
+	if (bdd->references != NULL) {
+		bdd->references = realloc(bdd->references, capacity * sizeof(*bdd->references));
+		bdd->level_chains = realloc(bdd->level_chains, capacity * sizeof(*bdd->level_chains));
+		assert(bdd->references != NULL && bdd->level_chains != NULL);
+	}
+	bdd->nodes_capacity = capacity;
+
+	if (capacity > bdd->buckets_count) {
+		boolean_bdd_resize_cache(bdd, capacity);
+		boolean_bdd_rehash(bdd, capacity);
+	}
+
+	return true;
+}
+
+static uint32_t boolean_bdd_make_node(
+	struct boolean_bdd *bdd,
+	uint32_t level,
+	uint32_t low,
+	uint32_t high
+) {
+	if (low == high || bdd->exhausted) {
+		return low;
+	}
+
+	// every step of an operation looks up a node, so counting them bounds the time between checks
+	if (++bdd->steps == DEADLINE_CHECK_INTERVAL) {
+		bdd->steps = 0;
+		if (boolean_budget_expired(bdd->budget)) {
+			bdd->exhausted = true;
+			bdd->expired = true;
+			return BOOLEAN_BDD_FALSE;
+		}
+	}
+
+	size_t bucket = boolean_bdd_hash(level, low, high) & (bdd->buckets_count - 1);
+	for (uint32_t i = bdd->buckets[bucket]; i != NO_NODE; i = bdd->chains[i]) {
+		const struct boolean_bdd_node *node = &bdd->nodes[i];
+		if (node->level == level && node->low == low && node->high == high) {
+			return i;
+		}
+	}
+
+	if (bdd->nodes_count == bdd->nodes_capacity && !boolean_bdd_grow(bdd)) {
+		bdd->exhausted = true;
+		return BOOLEAN_BDD_FALSE;
+	}
+
+	uint32_t index = (uint32_t)bdd->nodes_count++;
+	bdd->nodes[index] = (struct boolean_bdd_node){ level, low, high };
+	boolean_bdd_chain(bdd, index);
+
+	return index;
+}
+
+uint32_t boolean_bdd_variable(struct boolean_bdd *bdd, char name) {
+	assert(bdd != NULL);
+
+	uint32_t level = bdd->levels[boolean_environment_variable_index(name)];
+	assert(level != NO_NODE);
+
+	return boolean_bdd_make_node(bdd, level, BOOLEAN_BDD_FALSE, BOOLEAN_BDD_TRUE);
+}
+
+// combines two diagrams, the second node is ignored for a negation
+uint32_t boolean_bdd_apply(
+	struct boolean_bdd *bdd,
+	enum boolean_operation_type type,
+	uint32_t node_1,
+	uint32_t node_2
+) {
+	assert(bdd != NULL && node_1 < bdd->nodes_count);
+
+	if (type == boolean_operation_type_negation) {
+		type = boolean_operation_type_exclusive_disjunction;
+		node_2 = BOOLEAN_BDD_TRUE;
+	}
+	assert(node_2 < bdd->nodes_count);
+
+	if (bdd->exhausted) {
+		return BOOLEAN_BDD_FALSE;
+	}
+
+	switch (type) {
+		case boolean_operation_type_conjunction: {
+			if (node_1 == BOOLEAN_BDD_FALSE || node_2 == BOOLEAN_BDD_FALSE) {
+				return BOOLEAN_BDD_FALSE;
+			}
+			if (node_1 == BOOLEAN_BDD_TRUE || node_1 == node_2) {
+				return node_2;
+			}
+			if (node_2 == BOOLEAN_BDD_TRUE) {
+				return node_1;
+			}
+		} break;
+		case boolean_operation_type_disjunction: {
+			if (node_1 == BOOLEAN_BDD_TRUE || node_2 == BOOLEAN_BDD_TRUE) {
+				return BOOLEAN_BDD_TRUE;
+			}
+			if (node_1 == BOOLEAN_BDD_FALSE || node_1 == node_2) {
+				return node_2;
+			}
+			if (node_2 == BOOLEAN_BDD_FALSE) {
+				return node_1;
+			}
+		} break;
+		case boolean_operation_type_exclusive_disjunction: {
+			if (node_1 == node_2) {
+				return BOOLEAN_BDD_FALSE;
+			}
+			if (node_1 == BOOLEAN_BDD_FALSE) {
+				return node_2;
+			}
+			if (node_2 == BOOLEAN_BDD_FALSE) {
+				return node_1;
+			}
+			if (node_1 == BOOLEAN_BDD_TRUE && node_2 == BOOLEAN_BDD_TRUE) {
+				return BOOLEAN_BDD_FALSE;
+			}
+		} break;
+		case boolean_operation_type_negation: assert(false); break;
+	}
+
+	// all three operations are commutative
+	if (node_1 > node_2) {
+		uint32_t node = node_1;
+		node_1 = node_2;
+		node_2 = node;
+	}
+
+	size_t slot = boolean_bdd_hash((uint32_t)type, node_1, node_2) & (bdd->cache_count - 1);
+	const struct boolean_bdd_cache_entry *entry = &bdd->cache[slot];
+	if (entry->operation == (uint32_t)type && entry->node_1 == node_1 && entry->node_2 == node_2) {
+		return entry->result;
+	}
+
+	struct boolean_bdd_node top_1 = bdd->nodes[node_1];
+	struct boolean_bdd_node top_2 = bdd->nodes[node_2];
+	uint32_t level = top_1.level < top_2.level ? top_1.level : top_2.level;
+
+	uint32_t low_1 = top_1.level == level ? top_1.low : node_1;
+	uint32_t high_1 = top_1.level == level ? top_1.high : node_1;
+	uint32_t low_2 = top_2.level == level ? top_2.low : node_2;
+	uint32_t high_2 = top_2.level == level ? top_2.high : node_2;
+
+	uint32_t low = boolean_bdd_apply(bdd, type, low_1, low_2);
+	uint32_t high = boolean_bdd_apply(bdd, type, high_1, high_2);
+	uint32_t result = boolean_bdd_make_node(bdd, level, low, high);
+
+	// the cache may have been resized while recursing
+	if (!bdd->exhausted) {
+		slot = boolean_bdd_hash((uint32_t)type, node_1, node_2) & (bdd->cache_count - 1);
+		bdd->cache[slot] = (struct boolean_bdd_cache_entry){
+			.operation = (uint32_t)type,
+			.node_1 = node_1,
+			.node_2 = node_2,
+			.result = result,
+		};
+	}
+
+	return result;
+}
+
+static uint32_t boolean_bdd_from_expression_(
+	struct boolean_bdd *bdd,
+	const struct boolean_expression *expression
+) {
+	switch (expression->type) {
+		case boolean_expression_type_constant: {
+			return expression->constant.value ? BOOLEAN_BDD_TRUE : BOOLEAN_BDD_FALSE;
+		} break;
+		case boolean_expression_type_variable: {
+			return boolean_bdd_variable(bdd, expression->variable.name);
+		} break;
+		case boolean_expression_type_operation: {
+			const struct boolean_expression *operands = expression->operation.operands;
+			uint32_t node = boolean_bdd_from_expression_(bdd, &operands[0]);
+			if (expression->operation.type == boolean_operation_type_negation) {
+				return boolean_bdd_apply(bdd, boolean_operation_type_negation, node, node);
+			}
+
+			for (size_t i = 1; i < expression->operation.operands_count && !bdd->exhausted; i++) {
+				uint32_t operand = boolean_bdd_from_expression_(bdd, &operands[i]);
+				node = boolean_bdd_apply(bdd, expression->operation.type, node, operand);
+			}
+			return node;
+		} break;
+	}
+
+	return BOOLEAN_BDD_FALSE;
+}
+
+// every variable of the expression must be one of the diagram's
+struct boolean_status boolean_bdd_from_expression(
+	struct boolean_bdd *bdd,
+	const struct boolean_expression *expression,
+	uint32_t *node
+) {
+	assert(bdd != NULL && expression != NULL && node != NULL);
+
+	*node = boolean_bdd_from_expression_(bdd, expression);
+	if (bdd->expired) {
+		return boolean_status_failure("ran out of time while building the decision diagram");
+	}
+	if (bdd->exhausted) {
+		return boolean_status_failure(
+			"the decision diagram grew past the budget at %zu nodes",
+			bdd->nodes_count
+		);
+	}
+
+	return boolean_status_success();
+}
+
+static uint32_t boolean_bdd_compact_(
+	const struct boolean_bdd_node *nodes,
+	uint32_t node,
+	uint32_t *renumbered,
+	struct boolean_bdd_node *compacted,
+	size_t *count
+) {
+	if (renumbered[node] != NO_NODE) {
+		return renumbered[node];
+	}
+
+	uint32_t low = boolean_bdd_compact_(nodes, nodes[node].low, renumbered, compacted, count);
+	uint32_t high = boolean_bdd_compact_(nodes, nodes[node].high, renumbered, compacted, count);
+
+	uint32_t index = (uint32_t)(*count)++;
+	compacted[index] = (struct boolean_bdd_node){ nodes[node].level, low, high };
+	renumbered[node] = index;
+	return index;
+}
+
+// counts the references to every node, all of which are live, and chains the nodes of each level
+static void boolean_bdd_count_references(struct boolean_bdd *bdd, uint32_t node) {
+	memset(bdd->references, 0, bdd->nodes_count * sizeof(*bdd->references));
+	for (size_t i = 0; i < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT; i++) {
+		bdd->level_heads[i] = NO_NODE;
+	}
+
+	for (uint32_t i = 2; i < bdd->nodes_count; i++) {
+		const struct boolean_bdd_node *current = &bdd->nodes[i];
+		bdd->references[current->low]++;
+		bdd->references[current->high]++;
+		bdd->level_chains[i] = bdd->level_heads[current->level];
+		bdd->level_heads[current->level] = i;
+	}
+	bdd->references[node]++;
+	bdd->live_nodes_count = bdd->nodes_count - 2;
+}
+
+// keeps only the nodes under the given node, renumbered so that every node still comes after its
+// children, the node is updated to its new number
+void boolean_bdd_compact(struct boolean_bdd *bdd, uint32_t *node) {
+	assert(bdd != NULL && node != NULL && *node < bdd->nodes_count);
+
+	uint32_t *renumbered = malloc(bdd->nodes_count * sizeof(*renumbered));
+	struct boolean_bdd_node *compacted = malloc(bdd->nodes_capacity * sizeof(*compacted));
+	assert(renumbered != NULL && compacted != NULL);
+
+	for (size_t i = 0; i < bdd->nodes_count; i++) {
+		renumbered[i] = NO_NODE;
+	}
+	renumbered[BOOLEAN_BDD_FALSE] = BOOLEAN_BDD_FALSE;
+	renumbered[BOOLEAN_BDD_TRUE] = BOOLEAN_BDD_TRUE;
+	compacted[BOOLEAN_BDD_FALSE] = bdd->nodes[BOOLEAN_BDD_FALSE];
+	compacted[BOOLEAN_BDD_TRUE] = bdd->nodes[BOOLEAN_BDD_TRUE];
+
+	size_t count = 2;
+	*node = boolean_bdd_compact_(bdd->nodes, *node, renumbered, compacted, &count);
+	free(renumbered);
+
+	free(bdd->nodes);
+	bdd->nodes = compacted;
+	bdd->nodes_count = count;
+
+	if (bdd->references != NULL) {
+		boolean_bdd_count_references(bdd, *node);
+	}
+	boolean_bdd_rehash(bdd, bdd->buckets_count);
+	// the results in the cache refer to the nodes by their old numbers
+	boolean_bdd_resize_cache(bdd, bdd->cache_count);
+}
+
+// starts reordering the levels of the diagram in place, keeping only the nodes under the given
+// node, nothing else can be done with the diagram until reordering ends, returns false if the
+// references don't fit in the budget
+bool boolean_bdd_reorder_begin(struct boolean_bdd *bdd, uint32_t *node) {
+	assert(bdd != NULL && node != NULL && bdd->references == NULL);
+
+	size_t bytes =
+		bdd->nodes_capacity * (sizeof(*bdd->references) + sizeof(*bdd->level_chains));
+	if (!boolean_bdd_reserve(bdd, bytes)) {
+		return false;
+	}
+
+	bdd->references = malloc(bdd->nodes_capacity * sizeof(*bdd->references));
+	bdd->level_chains = malloc(bdd->nodes_capacity * sizeof(*bdd->level_chains));
+	assert(bdd->references != NULL && bdd->level_chains != NULL);
+
+	boolean_bdd_compact(bdd, node);
+
+	return true;
+}
+
+// ends reordering, dropping the nodes that died and renumbering the rest so that every node comes
+// after its children again
+void boolean_bdd_reorder_end(struct boolean_bdd *bdd, uint32_t *node) {
+	assert(bdd != NULL && node != NULL && bdd->references != NULL);
+
+	free(bdd->references);
+	free(bdd->level_chains);
+	bdd->references = NULL;
+	bdd->level_chains = NULL;
+
+	size_t bytes =
+		bdd->nodes_capacity * (sizeof(*bdd->references) + sizeof(*bdd->level_chains));
+	boolean_budget_release_bytes(bdd->budget, bytes);
+	bdd->reserved_bytes -= bytes;
+
+	boolean_bdd_compact(bdd, node);
+}
+
+// drops a reference to a node, which dies once nothing refers to it, dropping its own references
+static void boolean_bdd_dereference(struct boolean_bdd *bdd, uint32_t node) {
+	if (node == BOOLEAN_BDD_FALSE || node == BOOLEAN_BDD_TRUE) {
+		return;
+	}
+
+	assert(bdd->references[node] != 0);
+	if (--bdd->references[node] != 0) {
+		return;
+	}
+
+	boolean_bdd_unchain(bdd, node);
+	bdd->live_nodes_count--;
+	boolean_bdd_dereference(bdd, bdd->nodes[node].low);
+	boolean_bdd_dereference(bdd, bdd->nodes[node].high);
+}
+
+// the node with the given level and children while reordering, which is added to the level if
+// it's new, without any references yet, there must be room for it
+static uint32_t boolean_bdd_reorder_node(
+	struct boolean_bdd *bdd,
+	uint32_t level,
+	uint32_t low,
+	uint32_t high
+) {
+	if (low == high) {
+		return low;
+	}
+
+	size_t bucket = boolean_bdd_hash(level, low, high) & (bdd->buckets_count - 1);
+	for (uint32_t i = bdd->buckets[bucket]; i != NO_NODE; i = bdd->chains[i]) {
+		const struct boolean_bdd_node *node = &bdd->nodes[i];
+		if (node->level == level && node->low == low && node->high == high) {
+			return i;
+		}
+	}
+
+	assert(bdd->nodes_count < bdd->nodes_capacity);
+	uint32_t index = (uint32_t)bdd->nodes_count++;
+	bdd->nodes[index] = (struct boolean_bdd_node){ level, low, high };
+	boolean_bdd_chain(bdd, index);
+
+	bdd->references[index] = 0;
+	bdd->references[low]++;
+	bdd->references[high]++;
+	bdd->level_chains[index] = bdd->level_heads[level];
+	bdd->level_heads[level] = index;
+	bdd->live_nodes_count++;
+
+	return index;
+}
+
+// swaps the variables of the given level and the next one in place, every live node keeping its
+// number and the function it represents, returns false if the nodes it may create don't fit in
+// the budget, leaving the diagram as it was
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+bool boolean_bdd_swap(struct boolean_bdd *bdd, uint32_t level) {
+	assert(bdd != NULL && bdd->references != NULL && level + 1 < bdd->variables.length);
+
+	uint32_t upper = level;
+	uint32_t lower = level + 1;
+
+	size_t upper_count = 0;
+	for (uint32_t i = bdd->level_heads[upper]; i != NO_NODE; i = bdd->level_chains[i]) {
+		upper_count += bdd->references[i] != 0 ? 1U : 0U;
+	}
+
+	// each node of the upper level makes at most two new nodes
+	while (bdd->nodes_count + 2 * upper_count > bdd->nodes_capacity) {
+		if (!boolean_bdd_grow(bdd)) {
+			return false;
+		}
+	}
+
+	uint32_t *uppers = malloc(upper_count * sizeof(*uppers));
+	assert(uppers != NULL || upper_count == 0);
+	upper_count = 0;
+	for (uint32_t i = bdd->level_heads[upper]; i != NO_NODE; i = bdd->level_chains[i]) {
+		if (bdd->references[i] != 0) {
+			uppers[upper_count++] = i;
+			boolean_bdd_unchain(bdd, i);
+		}
+	}
+
+	// the nodes of the lower variable move up as they are, dead ones are dropped from the chains
+	uint32_t lowers = bdd->level_heads[lower];
+	bdd->level_heads[upper] = NO_NODE;
+	bdd->level_heads[lower] = NO_NODE;
+	for (uint32_t i = lowers, next = NO_NODE; i != NO_NODE; i = next) {
+		next = bdd->level_chains[i];
+		if (bdd->references[i] != 0) {
+			boolean_bdd_unchain(bdd, i);
+			bdd->nodes[i].level = upper;
+			boolean_bdd_chain(bdd, i);
+			bdd->level_chains[i] = bdd->level_heads[upper];
+			bdd->level_heads[upper] = i;
+		}
+	}
+
+	// the nodes of the upper variable that don't depend on the lower one move down as they are,
+	// before any new node of the lower level is made, which may turn out to be one of them
+	for (size_t i = 0; i < upper_count; i++) {
+		struct boolean_bdd_node *node = &bdd->nodes[uppers[i]];
+		if (bdd->nodes[node->low].level != upper && bdd->nodes[node->high].level != upper) {
+			node->level = lower;
+			boolean_bdd_chain(bdd, uppers[i]);
+			bdd->level_chains[uppers[i]] = bdd->level_heads[lower];
+			bdd->level_heads[lower] = uppers[i];
+		}
+	}
+
+	// the rest become nodes of the lower variable, now on the upper level, over new nodes of the
+	// upper variable, now on the lower level
+	for (size_t i = 0; i < upper_count; i++) {
+		uint32_t index = uppers[i];
+		struct boolean_bdd_node node = bdd->nodes[index];
+		if (node.level == lower) {
+			continue;
+		}
+
+		struct boolean_bdd_node low = bdd->nodes[node.low];
+		struct boolean_bdd_node high = bdd->nodes[node.high];
+		uint32_t low_low = low.level == upper ? low.low : node.low;
+		uint32_t low_high = low.level == upper ? low.high : node.low;
+		uint32_t high_low = high.level == upper ? high.low : node.high;
+		uint32_t high_high = high.level == upper ? high.high : node.high;
+
+		uint32_t new_low = boolean_bdd_reorder_node(bdd, lower, low_low, high_low);
+		bdd->references[new_low]++;
+		uint32_t new_high = boolean_bdd_reorder_node(bdd, lower, low_high, high_high);
+		bdd->references[new_high]++;
+
+		bdd->nodes[index] = (struct boolean_bdd_node){ upper, new_low, new_high };
+		boolean_bdd_chain(bdd, index);
+		bdd->level_chains[index] = bdd->level_heads[upper];
+		bdd->level_heads[upper] = index;
+
+		boolean_bdd_dereference(bdd, node.low);
+		boolean_bdd_dereference(bdd, node.high);
+	}
+	free(uppers);
+
+	char upper_name = bdd->variables.data[upper];
+	char lower_name = bdd->variables.data[lower];
+	bdd->variables.data[upper] = lower_name;
+	bdd->variables.data[lower] = upper_name;
+	bdd->levels[boolean_environment_variable_index(upper_name)] = lower;
+	bdd->levels[boolean_environment_variable_index(lower_name)] = upper;
+
+	return true;
+}
+
+// the number of nodes reachable from the node, terminals included
+size_t boolean_bdd_size(const struct boolean_bdd *bdd, uint32_t node) {
+	assert(bdd != NULL && node < bdd->nodes_count);
+
+	bool *visited = calloc(node + 1, sizeof(*visited));
+	uint32_t *stack = malloc(((size_t)node + 1) * sizeof(*stack));
+	assert(visited != NULL && stack != NULL);
+
+	size_t size = 0;
+	size_t stack_length = 0;
+	stack[stack_length++] = node;
+	visited[node] = true;
+	while (stack_length != 0) {
+		uint32_t top = stack[--stack_length];
+		size++;
+		if (top == BOOLEAN_BDD_FALSE || top == BOOLEAN_BDD_TRUE) {
+			continue;
+		}
+
+		uint32_t children[] = { bdd->nodes[top].low, bdd->nodes[top].high };
+		for (size_t i = 0; i < sizeof(children) / sizeof(*children); i++) {
+			if (!visited[children[i]]) {
+				visited[children[i]] = true;
+				stack[stack_length++] = children[i];
+			}
+		}
+	}
+
+	free(stack);
+	free(visited);
+
+	return size;
+}
+
+// the probability the function is true when each variable is independently true with the given
+// probability, indexed by environment variable, or a half if none are given
+double boolean_bdd_probability(
+	const struct boolean_bdd *bdd,
+	uint32_t node,
+	const double *probabilities
+) {
+	assert(bdd != NULL && node < bdd->nodes_count);
+
+	// children always come before their parents, so a single pass upwards suffices
+	double *node_probabilities = malloc(((size_t)node + 1) * sizeof(*node_probabilities));
+	assert(node_probabilities != NULL);
+
+	node_probabilities[BOOLEAN_BDD_FALSE] = 0.0;
+	if (node >= BOOLEAN_BDD_TRUE) {
+		node_probabilities[BOOLEAN_BDD_TRUE] = 1.0;
+	}
+	for (uint32_t i = 2; i <= node; i++) {
+		const struct boolean_bdd_node *current = &bdd->nodes[i];
+		double probability = 0.5;
+		if (probabilities != NULL) {
+			char name = bdd->variables.data[current->level];
+			probability = probabilities[boolean_environment_variable_index(name)];
+		}
+
+		node_probabilities[i] = (1.0 - probability) * node_probabilities[current->low] +
+								probability * node_probabilities[current->high];
+	}
+
+	double probability = node_probabilities[node];
+	free(node_probabilities);
+
+	return probability;
+}
@@ -0,0 +1,80 @@
+#include <bool_tool/boolean_budget.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <time.h>
+
+static double boolean_budget_now(void) {
+	struct timespec now;
+	if (timespec_get(&now, TIME_UTC) != TIME_UTC) {
+		return 0.0;
+	}
+
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+struct boolean_budget boolean_budget_new(
+	size_t maximum_bytes,
+	size_t maximum_implicants,
+	double maximum_seconds
+) {
+	assert(maximum_seconds >= 0.0);
+
+	return (struct boolean_budget){
+		.maximum_bytes = maximum_bytes,
+		.maximum_implicants = maximum_implicants,
+		.deadline = boolean_budget_now() + maximum_seconds,
+		.bytes = 0,
+		.implicants = 0,
+	};
+}
+
+// a budget of NULL is unlimited, so the functions below accept it everywhere
+
+bool boolean_budget_reserve_bytes(struct boolean_budget *budget, size_t bytes) {
+	if (budget == NULL) {
+		return true;
+	}
+
+	size_t reserved = atomic_load(&budget->bytes);
+	do {
+		if (bytes > budget->maximum_bytes - reserved) {
+			return false;
+		}
+	} while (!atomic_compare_exchange_weak(&budget->bytes, &reserved, reserved + bytes));
+
+	return true;
+}
+
+void boolean_budget_release_bytes(struct boolean_budget *budget, size_t bytes) {
+	if (budget == NULL) {
+		return;
+	}
+
+	assert(atomic_load(&budget->bytes) >= bytes);
+	atomic_fetch_sub(&budget->bytes, bytes);
+}
+
+bool boolean_budget_reserve_implicants(struct boolean_budget *budget, size_t implicants) {
+	if (budget == NULL) {
+		return true;
+	}
+
+	size_t reserved = atomic_load(&budget->implicants);
+	do {
+		if (implicants > budget->maximum_implicants - reserved) {
+			return false;
+		}
+	} while (!atomic_compare_exchange_weak(&budget->implicants, &reserved, reserved + implicants)
+	);
+
+	return true;
+}
+
+bool boolean_budget_expired(const struct boolean_budget *budget) {
+	if (budget == NULL) {
+		return false;
+	}
+
+	return boolean_budget_now() > budget->deadline;
+}
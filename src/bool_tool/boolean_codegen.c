@@ -0,0 +1,275 @@
+#include <bool_tool/boolean_codegen.h>
+
+#include <assert.h>
+#include <bool_tool/boolean_lanes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// a lookup table is only chosen if it fits comfortably in the first level cache, and the
+// expression takes more operations than indexing it does
+#define LOOKUP_TABLE_BYTES_MAXIMUM 4096
+#define LOOKUP_TABLE_OPERATIONS 6
+
+#define TABLE_WORDS_PER_LINE 4
+
+struct code {
+	char *data;
+	size_t length;
+	size_t capacity;
+};
+
+__attribute__((__format__(__printf__, 2, 3))) static void code_print(
+	struct code *code,
+	const char *format,
+	...
+) {
+	va_list arguments;
+	va_start(arguments, format);
+	int length = vsnprintf(NULL, 0, format, arguments);
+	va_end(arguments);
+	assert(length >= 0);
+
+	if (code->length + (size_t)length + 1 > code->capacity) {
+		code->capacity = (code->length + (size_t)length + 1) * 2;
+		code->data = realloc(code->data, code->capacity);
+		assert(code->data != NULL);
+	}
+
+	va_start(arguments, format);
+	(void)vsnprintf(&code->data[code->length], (size_t)length + 1, format, arguments);
+	va_end(arguments);
+	code->length += (size_t)length;
+}
+
+// the number of operations evaluating the expression takes, on top of reading its inputs
+static size_t boolean_codegen_operations(const struct boolean_expression *expression) {
+	if (expression->type != boolean_expression_type_operation) {
+		return 0;
+	}
+
+	size_t operations = expression->operation.operands_count - 1;
+	if (expression->operation.type == boolean_operation_type_negation) {
+		operations = 1;
+	}
+	for (size_t i = 0; i < expression->operation.operands_count; i++) {
+		operations += boolean_codegen_operations(&expression->operation.operands[i]);
+	}
+	return operations;
+}
+
+// every operation is parenthesized, as the precedence of the operators in c differs from ours
+static void boolean_codegen_expression(
+	struct code *code,
+	const struct boolean_expression *expression,
+	bool bit_sliced
+) {
+	switch (expression->type) {
+		case boolean_expression_type_constant: {
+			if (bit_sliced) {
+				code_print(code, "%s", expression->constant.value ? "UINT64_MAX" : "UINT64_C(0)");
+			} else {
+				code_print(code, "%s", expression->constant.value ? "1U" : "0U");
+			}
+		} break;
+		case boolean_expression_type_variable: {
+			code_print(code, "%c", expression->variable.name);
+		} break;
+		case boolean_expression_type_operation: {
+			const struct boolean_expression *operands = expression->operation.operands;
+			if (expression->operation.type == boolean_operation_type_negation) {
+				// scalars are single bits, so flipping the lowest bit negates them
+				if (bit_sliced) {
+					code_print(code, "~");
+				} else {
+					code_print(code, "(1U ^ ");
+				}
+				if (operands[0].type == boolean_expression_type_operation &&
+					operands[0].operation.type != boolean_operation_type_negation) {
+					code_print(code, "(");
+					boolean_codegen_expression(code, &operands[0], bit_sliced);
+					code_print(code, ")");
+				} else {
+					boolean_codegen_expression(code, &operands[0], bit_sliced);
+				}
+				if (!bit_sliced) {
+					code_print(code, ")");
+				}
+				break;
+			}
+
+			const char *separator = " & ";
+			if (expression->operation.type == boolean_operation_type_disjunction) {
+				separator = " | ";
+			} else if (expression->operation.type == boolean_operation_type_exclusive_disjunction) {
+				separator = " ^ ";
+			}
+
+			for (size_t i = 0; i < expression->operation.operands_count; i++) {
+				if (i != 0) {
+					code_print(code, "%s", separator);
+				}
+				if (operands[i].type == boolean_expression_type_operation &&
+					operands[i].operation.type != boolean_operation_type_negation) {
+					code_print(code, "(");
+					boolean_codegen_expression(code, &operands[i], bit_sliced);
+					code_print(code, ")");
+				} else {
+					boolean_codegen_expression(code, &operands[i], bit_sliced);
+				}
+			}
+		} break;
+	}
+}
+
+static void boolean_codegen_scalar(
+	struct code *code,
+	const struct boolean_expression *expression,
+	const struct boolean_variables *variables,
+	const char *name
+) {
+	struct boolean_environment support = boolean_environment_new();
+	boolean_variables_from_expression_(expression, &support);
+
+	code_print(code, "bool %s(uint64_t inputs) {\n", name);
+	if (support.variables == 0) {
+		code_print(code, "\t(void)inputs;\n");
+	}
+	for (size_t i = 0; i < variables->length; i++) {
+		if (boolean_environment_get_variable(&support, variables->data[i])) {
+			code_print(
+				code,
+				"\tconst unsigned int %c = (unsigned int)(inputs >> %zu) & 1U;\n",
+				variables->data[i],
+				variables->length - 1 - i
+			);
+		}
+	}
+	code_print(code, "\treturn (bool)(");
+	boolean_codegen_expression(code, expression, false);
+	code_print(code, ");\n}\n");
+}
+
+static void boolean_codegen_bit_sliced(
+	struct code *code,
+	const struct boolean_expression *expression,
+	const struct boolean_variables *variables,
+	const char *name
+) {
+	struct boolean_environment support = boolean_environment_new();
+	boolean_variables_from_expression_(expression, &support);
+
+	// an array of no inputs isn't valid c, so that one is only a pointer
+	if (variables->length == 0) {
+		code_print(code, "uint64_t %s(const uint64_t *inputs) {\n", name);
+	} else {
+		code_print(code, "uint64_t %s(const uint64_t inputs[%zu]) {\n", name, variables->length);
+	}
+	if (support.variables == 0) {
+		code_print(code, "\t(void)inputs;\n");
+	}
+	for (size_t i = 0; i < variables->length; i++) {
+		if (boolean_environment_get_variable(&support, variables->data[i])) {
+			code_print(code, "\tconst uint64_t %c = inputs[%zu];\n", variables->data[i], i);
+		}
+	}
+	code_print(code, "\treturn ");
+	boolean_codegen_expression(code, expression, true);
+	code_print(code, ";\n}\n");
+}
+
+static void boolean_codegen_lookup_table(
+	struct code *code,
+	const struct boolean_expression *expression,
+	const struct boolean_variables *variables,
+	const char *name
+) {
+	assert(variables->length <= BOOLEAN_CODEGEN_LOOKUP_TABLE_VARIABLES_MAXIMUM);
+
+	// the variable at position i of the variables is bit n - 1 - i of the row
+	struct boolean_lanes lanes = boolean_lanes_from_variables(variables);
+	size_t words_count = (size_t)boolean_lanes_words_count(&lanes);
+
+	code_print(code, "bool %s(uint64_t inputs) {\n", name);
+	code_print(code, "\tstatic const uint64_t table[%zu] = {", words_count);
+
+	for (size_t word = 0; word < words_count; word++) {
+		uint64_t value = boolean_lanes_evaluate(&lanes, expression, word);
+		code_print(
+			code,
+			"%sUINT64_C(0x%016llX),",
+			word % TABLE_WORDS_PER_LINE == 0 ? "\n\t\t" : " ",
+			(unsigned long long)value
+		);
+	}
+	code_print(code, "\n\t};\n");
+	code_print(code, "\treturn (bool)((table[inputs >> 6] >> (inputs & 63U)) & 1U);\n}\n");
+}
+
+// generates a self contained, branch free c function computing the expression, whose inputs are
+// the given variables, or null if it's asked for a lookup table over too many variables
+char *boolean_expression_to_c(
+	const struct boolean_expression *expression,
+	const struct boolean_variables *variables,
+	const char *name,
+	enum boolean_codegen_variant variant
+) {
+	assert(expression != NULL && variables != NULL && name != NULL);
+
+	struct boolean_environment support = boolean_environment_new();
+	boolean_variables_from_expression_(expression, &support);
+	for (size_t i = 0; i < variables->length; i++) {
+		boolean_environment_set_variable(&support, variables->data[i], false);
+	}
+	assert(support.variables == 0);
+
+	if (variant == boolean_codegen_variant_automatic) {
+		variant = boolean_codegen_variant_scalar;
+
+		// reading the inputs costs the same either way
+		if (variables->length <= BOOLEAN_CODEGEN_LOOKUP_TABLE_VARIABLES_MAXIMUM &&
+			((size_t)1 << variables->length) / 8 <= LOOKUP_TABLE_BYTES_MAXIMUM &&
+			boolean_codegen_operations(expression) > LOOKUP_TABLE_OPERATIONS) {
+			variant = boolean_codegen_variant_lookup_table;
+		}
+	}
+
+	if (variant == boolean_codegen_variant_lookup_table &&
+		variables->length > BOOLEAN_CODEGEN_LOOKUP_TABLE_VARIABLES_MAXIMUM) {
+		return NULL;
+	}
+
+	struct code code = { .data = NULL, .length = 0, .capacity = 0 };
+	code_print(&code, "#include <stdbool.h>\n#include <stdint.h>\n\n");
+	switch (variant) {
+		case boolean_codegen_variant_scalar: {
+			boolean_codegen_scalar(&code, expression, variables, name);
+		} break;
+		case boolean_codegen_variant_lookup_table: {
+			boolean_codegen_lookup_table(&code, expression, variables, name);
+		} break;
+		case boolean_codegen_variant_bit_sliced: {
+			boolean_codegen_bit_sliced(&code, expression, variables, name);
+		} break;
+		case boolean_codegen_variant_automatic: assert(false); break;
+	}
+
+	return code.data;
+}
+
+char *boolean_implicants_to_c(
+	const struct boolean_implicants *implicants,
+	const struct boolean_variables *variables,
+	const char *name,
+	enum boolean_codegen_variant variant
+) {
+	assert(implicants != NULL && variables != NULL && name != NULL);
+
+	struct boolean_expression expression =
+		boolean_expression_from_implicants(implicants, variables);
+	char *code = boolean_expression_to_c(&expression, variables, name, variant);
+	boolean_expression_drop(&expression);
+
+	return code;
+}
@@ -0,0 +1,239 @@
+#include <bool_tool/boolean_enumeration.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+#define NO_PARENT UINT32_MAX
+
+static size_t boolean_enumeration_nodes_count(const struct boolean_expression *expression) {
+	size_t count = 1;
+	if (expression->type == boolean_expression_type_operation) {
+		for (size_t i = 0; i < expression->operation.operands_count; i++) {
+			count += boolean_enumeration_nodes_count(&expression->operation.operands[i]);
+		}
+	}
+	return count;
+}
+
+// lays the nodes out in preorder, with the operands of each operation next to each other
+static uint32_t boolean_enumeration_flatten(
+	struct boolean_enumeration *enumeration,
+	const struct boolean_expression *expression,
+	uint32_t parent,
+	uint32_t *parents,
+	size_t *operands_count
+) {
+	uint32_t index = (uint32_t)enumeration->nodes_count++;
+	parents[index] = parent;
+
+	struct boolean_enumeration_node *node = &enumeration->nodes[index];
+	node->type = expression->type;
+	switch (expression->type) {
+		case boolean_expression_type_constant: {
+			node->value = expression->constant.value;
+		} break;
+		case boolean_expression_type_variable: {
+			node->index = boolean_environment_variable_index(expression->variable.name);
+		} break;
+		case boolean_expression_type_operation: {
+			node->operation.type = expression->operation.type;
+			node->operation.operands_offset = (uint32_t)*operands_count;
+			node->operation.operands_count = (uint32_t)expression->operation.operands_count;
+			*operands_count += expression->operation.operands_count;
+
+			for (size_t i = 0; i < expression->operation.operands_count; i++) {
+				uint32_t operand = boolean_enumeration_flatten(
+					enumeration,
+					&expression->operation.operands[i],
+					index,
+					parents,
+					operands_count
+				);
+				enumeration->operands[enumeration->nodes[index].operation.operands_offset + i] =
+					operand;
+			}
+		} break;
+	}
+
+	return index;
+}
+
+static int boolean_enumeration_compare_descending(const void *index_1, const void *index_2) {
+	uint32_t value_1 = *(const uint32_t *)index_1;
+	uint32_t value_2 = *(const uint32_t *)index_2;
+	return (value_1 < value_2) - (value_1 > value_2);
+}
+
+void boolean_enumeration_drop(struct boolean_enumeration *enumeration) {
+	assert(enumeration != NULL);
+
+	free(enumeration->nodes);
+	free(enumeration->operands);
+	free(enumeration->updates);
+}
+
+struct boolean_enumeration boolean_enumeration_new(const struct boolean_expression *expression) {
+	assert(expression != NULL);
+
+	size_t nodes_count = boolean_enumeration_nodes_count(expression);
+	assert(nodes_count < NO_PARENT);
+
+	struct boolean_enumeration enumeration = {
+		.nodes = malloc(nodes_count * sizeof(*enumeration.nodes)),
+		.nodes_count = 0,
+		.operands = malloc(nodes_count * sizeof(*enumeration.operands)),
+		.updates = NULL,
+		.updates_offsets = { 0 },
+	};
+	assert(enumeration.nodes != NULL && enumeration.operands != NULL);
+
+	uint32_t *parents = malloc(nodes_count * sizeof(*parents));
+	assert(parents != NULL);
+	size_t operands_count = 0;
+	(void)boolean_enumeration_flatten(
+		&enumeration,
+		expression,
+		NO_PARENT,
+		parents,
+		&operands_count
+	);
+
+	// the operations above the occurrences of a variable are gathered by walking up from each of
+	// them, until reaching one that's already been gathered
+	size_t *marks = malloc(nodes_count * sizeof(*marks));
+	assert(marks != NULL);
+	for (size_t i = 0; i < nodes_count; i++) {
+		marks[i] = SIZE_MAX;
+	}
+
+	size_t updates_capacity = nodes_count;
+	enumeration.updates = malloc(updates_capacity * sizeof(*enumeration.updates));
+	assert(enumeration.updates != NULL);
+
+	size_t updates_count = 0;
+	for (size_t variable = 0; variable < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT; variable++) {
+		enumeration.updates_offsets[variable] = updates_count;
+
+		for (uint32_t i = 0; i < nodes_count; i++) {
+			if (enumeration.nodes[i].type != boolean_expression_type_variable ||
+				enumeration.nodes[i].index != variable) {
+				continue;
+			}
+
+			for (uint32_t node = i; node != NO_PARENT && marks[node] != variable;
+				 node = parents[node]) {
+				marks[node] = variable;
+
+				if (updates_count == updates_capacity) {
+					assert(updates_capacity < SIZE_MAX / 2);
+					updates_capacity *= 2;
+					uint32_t *updates =
+						realloc(enumeration.updates, updates_capacity * sizeof(*updates));
+					assert(updates != NULL);
+					enumeration.updates = updates;
+				}
+				enumeration.updates[updates_count++] = node;
+			}
+		}
+
+		// the operands of an operation come after it in preorder, so going from the last node to
+		// the first updates them before it
+		size_t offset = enumeration.updates_offsets[variable];
+		qsort(
+			&enumeration.updates[offset],
+			updates_count - offset,
+			sizeof(*enumeration.updates),
+			boolean_enumeration_compare_descending
+		);
+	}
+	enumeration.updates_offsets[BOOLEAN_ENVIRONMENT_VARIABLES_COUNT] = updates_count;
+
+	free(marks);
+	free(parents);
+
+	return enumeration;
+}
+
+static uint64_t boolean_enumeration_node_evaluate(
+	const struct boolean_enumeration *enumeration,
+	uint32_t index,
+	const uint64_t *words,
+	const uint64_t *values
+) {
+	const struct boolean_enumeration_node *node = &enumeration->nodes[index];
+	switch (node->type) {
+		case boolean_expression_type_constant: {
+			return node->value ? UINT64_MAX : 0;
+		} break;
+		case boolean_expression_type_variable: {
+			return words[node->index];
+		} break;
+		case boolean_expression_type_operation: {
+			const uint32_t *operands = &enumeration->operands[node->operation.operands_offset];
+			uint32_t operands_count = node->operation.operands_count;
+			switch (node->operation.type) {
+				case boolean_operation_type_conjunction: {
+					uint64_t word = UINT64_MAX;
+					for (uint32_t i = 0; i < operands_count; i++) {
+						word &= values[operands[i]];
+					}
+					return word;
+				}
+				case boolean_operation_type_disjunction: {
+					uint64_t word = 0;
+					for (uint32_t i = 0; i < operands_count; i++) {
+						word |= values[operands[i]];
+					}
+					return word;
+				}
+				case boolean_operation_type_exclusive_disjunction: {
+					uint64_t word = 0;
+					for (uint32_t i = 0; i < operands_count; i++) {
+						word ^= values[operands[i]];
+					}
+					return word;
+				}
+				case boolean_operation_type_negation: {
+					return ~values[operands[0]];
+				}
+			}
+		} break;
+	}
+
+	return 0;
+}
+
+// evaluates every node over the rows of a word, given the value of each variable over them by its
+// index in the environment, the value of the expression being the first
+void boolean_enumeration_evaluate(
+	const struct boolean_enumeration *enumeration,
+	const uint64_t *words,
+	uint64_t *values
+) {
+	assert(enumeration != NULL && words != NULL && values != NULL);
+
+	for (size_t i = enumeration->nodes_count; i-- != 0;) {
+		values[i] = boolean_enumeration_node_evaluate(enumeration, (uint32_t)i, words, values);
+	}
+}
+
+// complements the variable with the given index in the environment over every row, and updates
+// the operations above it
+void boolean_enumeration_flip(
+	const struct boolean_enumeration *enumeration,
+	size_t index,
+	uint64_t *values
+) {
+	assert(enumeration != NULL && index < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT && values != NULL);
+
+	for (size_t i = enumeration->updates_offsets[index];
+		 i < enumeration->updates_offsets[index + 1];
+		 i++) {
+		uint32_t node = enumeration->updates[i];
+		if (enumeration->nodes[node].type == boolean_expression_type_variable) {
+			values[node] = ~values[node];
+		} else {
+			values[node] = boolean_enumeration_node_evaluate(enumeration, node, NULL, values);
+		}
+	}
+}
@@ -4,8 +4,18 @@
 #include <ctype.h>
 #include <stddef.h>
 
-#define VARIABLE_NAME_TO_INDEX(name)                                                               \
-	(islower(name) ? (size_t)((name) - 'a') : (size_t)((name) - 'A' + ('z' - 'a' + 1)))
+size_t boolean_environment_variable_index(char name) {
+	assert(isalpha((unsigned char)name));
+
+	return islower((unsigned char)name) ? (size_t)(name - 'a')
+										: (size_t)(name - 'A' + ('z' - 'a' + 1));
+}
+
+char boolean_environment_variable_name(size_t index) {
+	assert(index < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT);
+
+	return (char)(index < ('z' - 'a' + 1) ? 'a' + index : 'A' + (index - ('z' - 'a' + 1)));
+}
 
 struct boolean_environment boolean_environment_new(void) {
 	return (struct boolean_environment){
@@ -16,7 +26,7 @@ struct boolean_environment boolean_environment_new(void) {
 bool boolean_environment_get_variable(const struct boolean_environment *environment, char name) {
 	assert(environment != NULL && isalpha((unsigned char)name));
 
-	return (environment->variables >> VARIABLE_NAME_TO_INDEX(name)) & 1U;
+	return (environment->variables >> boolean_environment_variable_index(name)) & 1U;
 }
 
 void boolean_environment_set_variable(
@@ -26,6 +36,7 @@ void boolean_environment_set_variable(
 ) {
 	assert(environment != NULL && isalpha((unsigned char)name));
 
-	environment->variables &= ~(1U << VARIABLE_NAME_TO_INDEX(name));
-	environment->variables |= ((unsigned)value << VARIABLE_NAME_TO_INDEX(name));
+	size_t index = boolean_environment_variable_index(name);
+	environment->variables &= ~(UINT64_C(1) << index);
+	environment->variables |= ((uint64_t)value << index);
 }
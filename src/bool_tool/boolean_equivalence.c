@@ -0,0 +1,165 @@
+#include <bool_tool/boolean_equivalence.h>
+
+#include <assert.h>
+#include <bool_tool/boolean_lanes.h>
+#include <bool_tool/boolean_rewrite.h>
+#include <bool_tool/boolean_sat.h>
+#include <bool_tool/boolean_variables.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// up to this many variables, the truth table is searched a word of rows at a time, past it a SAT
+// solver is used
+#define WORD_PARALLEL_VARIABLES_MAXIMUM 24
+
+#define BUDGET_CHECK_INTERVAL 1024
+
+// looks for a row of the truth table where the expression is true, a word at a time, stopping at
+// the first word that has one
+static struct boolean_status boolean_expression_find_row(
+	const struct boolean_expression *expression,
+	const struct boolean_environment *support,
+	struct boolean_budget *budget,
+	bool *found,
+	struct boolean_environment *model
+) {
+	struct boolean_lanes lanes = boolean_lanes_from_support(support);
+	assert(lanes.variables_count <= WORD_PARALLEL_VARIABLES_MAXIMUM);
+
+	uint64_t words_count = boolean_lanes_words_count(&lanes);
+	for (uint64_t block = 0; block < words_count; block++) {
+		if (block % BUDGET_CHECK_INTERVAL == BUDGET_CHECK_INTERVAL - 1 &&
+			boolean_budget_expired(budget)) {
+			return boolean_status_failure("ran out of time while searching the truth table");
+		}
+
+		uint64_t word = boolean_lanes_evaluate(&lanes, expression, block);
+		if (word != 0) {
+			uint64_t lane = (uint64_t)__builtin_ctzll(word);
+			for (size_t i = 0; i < lanes.variables_count; i++) {
+				bool value = ((lanes.words[lanes.indices[i]] >> lane) & 1U) != 0;
+				model->variables |= (uint64_t)value << lanes.indices[i];
+			}
+			*found = true;
+			return boolean_status_success();
+		}
+	}
+
+	*found = false;
+	return boolean_status_success();
+}
+
+// hands expressions over too many variables for their truth table to a SAT solver
+static struct boolean_status boolean_expression_find_model(
+	const struct boolean_expression *expression,
+	struct boolean_budget *budget,
+	bool *found,
+	struct boolean_environment *model
+) {
+	struct boolean_sat sat = boolean_sat_new();
+
+	int variables[BOOLEAN_ENVIRONMENT_VARIABLES_COUNT] = { 0 };
+	int output = boolean_sat_add_expression(&sat, expression, variables);
+	boolean_sat_add_clause(&sat, &output, 1);
+
+	enum boolean_sat_result result = boolean_sat_solve(&sat, NULL, 0, budget);
+	if (result == boolean_sat_result_satisfiable) {
+		for (size_t i = 0; i < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT; i++) {
+			if (variables[i] != 0 && boolean_sat_value(&sat, variables[i])) {
+				model->variables |= UINT64_C(1) << i;
+			}
+		}
+	}
+
+	boolean_sat_drop(&sat);
+
+	if (result == boolean_sat_result_unknown) {
+		return boolean_status_failure("ran out of time while solving for a model");
+	}
+
+	*found = result == boolean_sat_result_satisfiable;
+	return boolean_status_success();
+}
+
+// if it is, the model is set to an environment where the expression is true
+struct boolean_status boolean_expression_is_satisfiable(
+	const struct boolean_expression *expression,
+	struct boolean_budget *budget,
+	bool *satisfiable,
+	struct boolean_environment *model
+) {
+	assert(expression != NULL && satisfiable != NULL);
+
+	struct boolean_expression rewritten = boolean_expression_clone(expression);
+	boolean_expression_rewrite(&rewritten);
+
+	struct boolean_environment support = boolean_environment_new();
+	boolean_variables_from_expression_(&rewritten, &support);
+
+	struct boolean_environment environment = boolean_environment_new();
+	struct boolean_status status;
+	if (__builtin_popcountll(support.variables) <= WORD_PARALLEL_VARIABLES_MAXIMUM) {
+		status = boolean_expression_find_row(
+			&rewritten,
+			&support,
+			budget,
+			satisfiable,
+			&environment
+		);
+	} else {
+		status = boolean_expression_find_model(&rewritten, budget, satisfiable, &environment);
+	}
+	boolean_expression_drop(&rewritten);
+
+	if (status.type == boolean_status_type_success && *satisfiable && model != NULL) {
+		*model = environment;
+	}
+
+	return status;
+}
+
+// if it isn't, the counterexample is set to an environment where the expression is false
+struct boolean_status boolean_expression_is_tautology(
+	const struct boolean_expression *expression,
+	struct boolean_budget *budget,
+	bool *tautology,
+	struct boolean_environment *counterexample
+) {
+	assert(expression != NULL && tautology != NULL);
+
+	struct boolean_expression negation = boolean_expression_new_operation(
+		boolean_operation_type_negation,
+		boolean_expression_clone(expression)
+	);
+	bool satisfiable = false;
+	struct boolean_status status =
+		boolean_expression_is_satisfiable(&negation, budget, &satisfiable, counterexample);
+	boolean_expression_drop(&negation);
+
+	*tautology = !satisfiable;
+	return status;
+}
+
+// if they aren't, the counterexample is set to an environment where they differ
+struct boolean_status boolean_expression_equivalent(
+	const struct boolean_expression *expression_1,
+	const struct boolean_expression *expression_2,
+	struct boolean_budget *budget,
+	bool *equivalent,
+	struct boolean_environment *counterexample
+) {
+	assert(expression_1 != NULL && expression_2 != NULL && equivalent != NULL);
+
+	struct boolean_expression difference = boolean_expression_new_operation(
+		boolean_operation_type_exclusive_disjunction,
+		boolean_expression_clone(expression_1),
+		boolean_expression_clone(expression_2)
+	);
+	bool satisfiable = false;
+	struct boolean_status status =
+		boolean_expression_is_satisfiable(&difference, budget, &satisfiable, counterexample);
+	boolean_expression_drop(&difference);
+
+	*equivalent = !satisfiable;
+	return status;
+}
@@ -3,9 +3,9 @@
 #include <assert.h>
 #include <bool_tool/boolean_implicants.h>
 #include <bool_tool/boolean_minterms.h>
+#include <bool_tool/boolean_parallel.h>
 #include <bool_tool/boolean_variables.h>
 #include <ctype.h>
-#include <errno.h>
 #include <float.h>
 #include <limits.h>
 #include <stdarg.h>
@@ -15,15 +15,19 @@
 #include <stdlib.h>
 #include <string.h>
 
+// the number of operands taken by boolean_expression_new_operation, other than negations,
+// operations built through boolean_expression_new_operation_from_operands may have any number of
+// operands
 size_t boolean_operation_type_arity(enum boolean_operation_type type) {
-	return 1 + (type <= boolean_operation_type_disjunction);
+	return 1 + (type != boolean_operation_type_negation);
 }
 
 size_t boolean_operation_type_precedence(enum boolean_operation_type type) {
 	switch (type) {
 		case boolean_operation_type_disjunction: return 0;
-		case boolean_operation_type_conjunction: return 1;
-		case boolean_operation_type_negation: return 2;
+		case boolean_operation_type_exclusive_disjunction: return 1;
+		case boolean_operation_type_conjunction: return 2;
+		case boolean_operation_type_negation: return 3;
 		default: assert(false);
 	}
 }
@@ -35,8 +39,7 @@ void boolean_expression_drop(struct boolean_expression *expression) {
 		case boolean_expression_type_constant:
 		case boolean_expression_type_variable: break;
 		case boolean_expression_type_operation: {
-			size_t arity = boolean_operation_type_arity(expression->operation.type);
-			for (size_t i = 0; i < arity; i++) {
+			for (size_t i = 0; i < expression->operation.operands_count; i++) {
 				boolean_expression_drop(&expression->operation.operands[i]);
 			}
 			free(expression->operation.operands);
@@ -73,7 +76,30 @@ struct boolean_expression boolean_expression_new_operation(enum boolean_operatio
 
 	return (struct boolean_expression){
 		.type = boolean_expression_type_operation,
-		.operation = { .type = type, .operands = operands },
+		.operation = { .type = type, .operands = operands, .operands_count = arity },
+	};
+}
+struct boolean_expression boolean_expression_new_operation_from_operands(
+	enum boolean_operation_type type,
+	struct boolean_expression *operands,
+	size_t operands_count
+) {
+	assert(operands != NULL || operands_count == 0);
+	assert(type != boolean_operation_type_negation || operands_count == 1);
+
+	// empty and singleton operations other than negation aren't operations at all
+	if (operands_count <= 1 && type != boolean_operation_type_negation) {
+		struct boolean_expression expression =
+			operands_count == 0
+				? boolean_expression_new_constant(type == boolean_operation_type_conjunction)
+				: operands[0];
+		free(operands);
+		return expression;
+	}
+
+	return (struct boolean_expression){
+		.type = boolean_expression_type_operation,
+		.operation = { .type = type, .operands = operands, .operands_count = operands_count },
 	};
 }
 
@@ -84,14 +110,19 @@ struct boolean_expression boolean_expression_clone(const struct boolean_expressi
 		case boolean_expression_type_constant:
 		case boolean_expression_type_variable: return *expression;
 		case boolean_expression_type_operation: {
-			size_t arity = boolean_operation_type_arity(expression->operation.type);
-			struct boolean_expression *operands = malloc(arity * sizeof(*operands));
-			for (size_t i = 0; i < arity; i++) {
+			size_t operands_count = expression->operation.operands_count;
+			struct boolean_expression *operands = malloc(operands_count * sizeof(*operands));
+			assert(operands != NULL);
+			for (size_t i = 0; i < operands_count; i++) {
 				operands[i] = boolean_expression_clone(&expression->operation.operands[i]);
 			}
 			return (struct boolean_expression){
 				.type = boolean_expression_type_operation,
-				.operation = { .type = expression->operation.type, .operands = operands },
+				.operation = {
+					.type = expression->operation.type,
+					.operands = operands,
+					.operands_count = operands_count,
+				},
 			};
 		} break;
 	}
@@ -99,193 +130,398 @@ struct boolean_expression boolean_expression_clone(const struct boolean_expressi
 	return (struct boolean_expression){ 0 };
 }
 
-static struct boolean_expression boolean_expression_from_string_expression(const char **string);
-// NOLINTNEXTLINE(readability-function-cognitive-complexity)
-static struct boolean_expression boolean_expression_from_string_atom(const char **string) {
-	assert(string != NULL && *string != NULL);
-
-	struct boolean_expression atom;
-
-	while (isspace((unsigned char)**string)) {
-		++*string;
+// constants come first, then literals ordered by variable with a literal directly followed by its
+// negation, then any other operations
+static int boolean_expression_compare_rank(const struct boolean_expression *expression) {
+	switch (expression->type) {
+		case boolean_expression_type_constant: return 0;
+		case boolean_expression_type_variable: return 1;
+		case boolean_expression_type_operation: {
+			if (expression->operation.type == boolean_operation_type_negation &&
+				expression->operation.operands[0].type == boolean_expression_type_variable) {
+				return 1;
+			}
+			return 2;
+		}
 	}
 
-	if (**string == '(') {
-		++*string;
-
-		atom = boolean_expression_from_string_expression(string);
+	return 0;
+}
+int boolean_expression_compare(
+	const struct boolean_expression *expression_1,
+	const struct boolean_expression *expression_2
+) {
+	assert(expression_1 != NULL && expression_2 != NULL);
 
-		while (isspace((unsigned char)**string)) {
-			++*string;
-		}
+	int rank_1 = boolean_expression_compare_rank(expression_1);
+	int rank_2 = boolean_expression_compare_rank(expression_2);
+	if (rank_1 != rank_2) {
+		return rank_1 < rank_2 ? -1 : 1;
+	}
 
-		if (**string == ')') {
-			++*string;
-		} else {
-			(void)fprintf(stderr, "Warning: unclosed parentheses \"%s\"\n", *string);
+	switch (rank_1) {
+		case 0: return (int)expression_1->constant.value - (int)expression_2->constant.value;
+		case 1: {
+			bool negated_1 = expression_1->type == boolean_expression_type_operation;
+			bool negated_2 = expression_2->type == boolean_expression_type_operation;
+			size_t index_1 = boolean_environment_variable_index(
+				negated_1 ? expression_1->operation.operands[0].variable.name
+						  : expression_1->variable.name
+			);
+			size_t index_2 = boolean_environment_variable_index(
+				negated_2 ? expression_2->operation.operands[0].variable.name
+						  : expression_2->variable.name
+			);
+			if (index_1 != index_2) {
+				return index_1 < index_2 ? -1 : 1;
+			}
+			return (int)negated_1 - (int)negated_2;
 		}
-	} else if (isalpha((unsigned char)**string)) {
-		char name = **string;
-
-		++*string;
-
-		atom = boolean_expression_new_variable(name);
-	} else {
-		char *end = NULL;
-		long value = strtol(*string, &end, 10);
-		if (end == *string) {
-			(void)fprintf(stderr, "Error: failed to parse constant from \"%s\"\n", *string);
-			value = false;
+		default: {
+			const struct boolean_operation *operation_1 = &expression_1->operation;
+			const struct boolean_operation *operation_2 = &expression_2->operation;
+			if (operation_1->type != operation_2->type) {
+				return operation_1->type < operation_2->type ? -1 : 1;
+			}
+			if (operation_1->operands_count != operation_2->operands_count) {
+				return operation_1->operands_count < operation_2->operands_count ? -1 : 1;
+			}
+			for (size_t i = 0; i < operation_1->operands_count; i++) {
+				int comparison = boolean_expression_compare(
+					&operation_1->operands[i],
+					&operation_2->operands[i]
+				);
+				if (comparison != 0) {
+					return comparison;
+				}
+			}
+			return 0;
 		}
+	}
+}
+static int boolean_expression_compare_(const void *expression_1, const void *expression_2) {
+	return boolean_expression_compare(expression_1, expression_2);
+}
 
-		if (errno == ERANGE) {
-			(void
-			)fprintf(stderr, "Warning: constant parsed from \"%s\" is out of range\n", *string);
+struct parser {
+	// the operands, each with the depth of its tree
+	struct boolean_expression *operands;
+	size_t *depths;
+	size_t operands_count;
+	size_t operands_capacity;
+	struct parser_operator {
+		enum parser_operator_type {
+			parser_operator_type_parenthesis,
+			parser_operator_type_operation,
+		} type;
+		enum boolean_operation_type operation_type;
+		size_t operands_count;
+		size_t position;
+	} *operators;
+	size_t operators_count;
+	size_t operators_capacity;
+};
+static void parser_drop(struct parser *parser) {
+	assert(parser != NULL);
+
+	for (size_t i = 0; i < parser->operands_count; i++) {
+		boolean_expression_drop(&parser->operands[i]);
+	}
+	free(parser->operands);
+	free(parser->depths);
+	free(parser->operators);
+}
+static bool parser_push_operand(struct parser *parser, struct boolean_expression operand) {
+	assert(parser != NULL);
+
+	if (parser->operands_count == parser->operands_capacity) {
+		size_t capacity = parser->operands_capacity == 0 ? 16 : parser->operands_capacity * 2;
+		struct boolean_expression *operands =
+			realloc(parser->operands, capacity * sizeof(*parser->operands));
+		if (operands == NULL) {
+			boolean_expression_drop(&operand);
+			return false;
 		}
+		parser->operands = operands;
 
-		if (value != 0 && value != 1) {
-			(void)fprintf(
-				stderr,
-				"Warning: non-zero constant parsed from \"%s\" will be implicitly converted into a "
-				"1\n",
-				*string
-			);
+		size_t *depths = realloc(parser->depths, capacity * sizeof(*parser->depths));
+		if (depths == NULL) {
+			boolean_expression_drop(&operand);
+			return false;
 		}
+		parser->depths = depths;
 
-		*string = end;
-
-		atom = boolean_expression_new_constant(value);
+		parser->operands_capacity = capacity;
 	}
 
-	return atom;
-}
-static struct boolean_expression boolean_expression_from_string_primary(const char **string) {
-	assert(string != NULL && *string != NULL);
+	parser->depths[parser->operands_count] = 1;
+	parser->operands[parser->operands_count++] = operand;
 
-	struct boolean_expression primary;
+	return true;
+}
+static bool parser_push_operator(struct parser *parser, struct parser_operator entry) {
+	assert(parser != NULL);
+
+	if (parser->operators_count == parser->operators_capacity) {
+		size_t capacity = parser->operators_capacity == 0 ? 16 : parser->operators_capacity * 2;
+		struct parser_operator *operators =
+			realloc(parser->operators, capacity * sizeof(*parser->operators));
+		if (operators == NULL) {
+			return false;
+		}
 
-	while (isspace((unsigned char)**string)) {
-		++*string;
+		parser->operators = operators;
+		parser->operators_capacity = capacity;
 	}
 
-	if (**string == '!') {
-		++*string;
+	parser->operators[parser->operators_count++] = entry;
 
-		primary = boolean_expression_new_operation(
-			boolean_operation_type_negation,
-			boolean_expression_from_string_primary(string)
-		);
-	} else {
-		primary = boolean_expression_from_string_atom(string);
-	}
+	return true;
+}
+// applies the operators on top of the stack, as long as they bind at least as tight as the given
+// precedence, stopping at the first open parenthesis
+static struct boolean_status parser_reduce(struct parser *parser, size_t precedence) {
+	assert(parser != NULL);
+
+	while (parser->operators_count != 0) {
+		const struct parser_operator *top = &parser->operators[parser->operators_count - 1];
+		if (top->type == parser_operator_type_parenthesis ||
+			boolean_operation_type_precedence(top->operation_type) < precedence) {
+			break;
+		}
 
-	while (isspace((unsigned char)**string)) {
-		++*string;
-	}
+		assert(parser->operands_count >= top->operands_count);
 
-	while (1) {
-		while (isspace((unsigned char)**string)) {
-			++*string;
+		size_t depth = 0;
+		for (size_t i = parser->operands_count - top->operands_count; i < parser->operands_count;
+			 i++) {
+			depth = parser->depths[i] > depth ? parser->depths[i] : depth;
+		}
+		if (depth >= BOOLEAN_EXPRESSION_DEPTH_MAXIMUM) {
+			return boolean_status_failure(
+				"expression nested deeper than %d levels at column %zu",
+				BOOLEAN_EXPRESSION_DEPTH_MAXIMUM,
+				top->position
+			);
 		}
 
-		if (**string == '\'') {
-			++*string;
-			primary = boolean_expression_new_operation(boolean_operation_type_negation, primary);
-		} else {
-			break;
+		struct boolean_expression *operands =
+			malloc(top->operands_count * sizeof(*parser->operands));
+		if (operands == NULL) {
+			return boolean_status_failure("out of memory while parsing expression");
 		}
+		parser->operands_count -= top->operands_count;
+		memcpy(
+			operands,
+			&parser->operands[parser->operands_count],
+			top->operands_count * sizeof(*parser->operands)
+		);
+
+		parser->depths[parser->operands_count] = depth + 1;
+		parser->operands[parser->operands_count++] = boolean_expression_new_operation_from_operands(
+			top->operation_type,
+			operands,
+			top->operands_count
+		);
+		parser->operators_count--;
 	}
 
-	return primary;
+	return boolean_status_success();
 }
-static struct boolean_expression boolean_expression_from_string_factor(const char **string) {
-	assert(string != NULL && *string != NULL);
+// pushes a binary operator, or if an operator of the same type is pending on the same level, adds
+// another operand to it, so chains of conjunctions and disjunctions become a single n-ary node
+static struct boolean_status parser_push_binary_operator(
+	struct parser *parser,
+	enum boolean_operation_type type,
+	size_t position
+) {
+	assert(parser != NULL);
 
-	struct boolean_expression factor = boolean_expression_from_string_primary(string);
+	size_t precedence = boolean_operation_type_precedence(type);
 
-	while (1) {
-		while (isspace((unsigned char)**string)) {
-			++*string;
+	struct boolean_status status = parser_reduce(parser, precedence + 1);
+	if (status.type == boolean_status_type_failure) {
+		return status;
+	}
+
+	if (parser->operators_count != 0) {
+		struct parser_operator *top = &parser->operators[parser->operators_count - 1];
+		if (top->type == parser_operator_type_operation && top->operation_type == type) {
+			top->operands_count++;
+			return boolean_status_success();
 		}
+	}
 
-		if (**string == '!' || **string == '(' || isalpha((unsigned char)**string)) {
-			factor = boolean_expression_new_operation(
-				boolean_operation_type_conjunction,
-				factor,
-				boolean_expression_from_string_primary(string)
-			);
-		} else {
-			break;
+	status = parser_reduce(parser, precedence);
+	if (status.type == boolean_status_type_failure) {
+		return status;
+	}
+
+	bool pushed = parser_push_operator(
+		parser,
+		(struct parser_operator){
+			.type = parser_operator_type_operation,
+			.operation_type = type,
+			.operands_count = 2,
+			.position = position,
 		}
+	);
+	if (!pushed) {
+		return boolean_status_failure("out of memory while parsing expression");
 	}
 
-	return factor;
+	return boolean_status_success();
 }
-static struct boolean_expression boolean_expression_from_string_term(const char **string) {
-	assert(string != NULL && *string != NULL);
 
-	struct boolean_expression expression = boolean_expression_from_string_factor(string);
-
-	while (1) {
-		while (isspace((unsigned char)**string)) {
-			++*string;
-		}
+// parses the expression using an explicit operator stack (shunting-yard), so neither deep nesting
+// nor long chains of operators consume any native stack, and the whole string is scanned once, the
+// trees nested deeper than BOOLEAN_EXPRESSION_DEPTH_MAXIMUM are rejected, since everything walking
+// them afterwards recurses
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+struct boolean_status boolean_expression_from_string(
+	const char *string,
+	struct boolean_expression *expression
+) {
+	assert(string != NULL && expression != NULL);
 
-		switch (**string) {
-			case '&':
-			case '*': {
-				++*string;
+	struct parser parser = { 0 };
 
-				expression = boolean_expression_new_operation(
-					boolean_operation_type_conjunction,
-					expression,
-					boolean_expression_from_string_factor(string)
-				);
-			} break;
-			default: return expression;
-		}
-	}
-}
-static struct boolean_expression boolean_expression_from_string_expression(const char **string) {
-	assert(string != NULL && *string != NULL);
+	// whether the parser is expecting an operand, or an operator following a complete operand
+	bool expecting_operand = true;
 
-	struct boolean_expression expression = boolean_expression_from_string_term(string);
+#define COLUMN(pointer) ((size_t)((pointer) - string) + 1)
+#define FAIL(...)                                                                                  \
+	do {                                                                                           \
+		parser_drop(&parser);                                                                      \
+		return boolean_status_failure(__VA_ARGS__);                                                \
+	} while (0)
+#define PUSH_OPERAND(operand)                                                                      \
+	do {                                                                                           \
+		if (!parser_push_operand(&parser, (operand))) {                                            \
+			FAIL("out of memory while parsing expression");                                        \
+		}                                                                                          \
+	} while (0)
+#define PUSH_OPERATOR(...)                                                                         \
+	do {                                                                                           \
+		if (!parser_push_operator(&parser, (struct parser_operator){ __VA_ARGS__ })) {             \
+			FAIL("out of memory while parsing expression");                                        \
+		}                                                                                          \
+	} while (0)
+#define CHECK(status_expression)                                                                   \
+	do {                                                                                           \
+		struct boolean_status status = (status_expression);                                        \
+		if (status.type == boolean_status_type_failure) {                                          \
+			parser_drop(&parser);                                                                  \
+			return status;                                                                         \
+		}                                                                                          \
+	} while (0)
+#define PUSH_BINARY_OPERATOR(type)                                                                 \
+	CHECK(parser_push_binary_operator(&parser, (type), COLUMN(cursor)))
+#define REDUCE(precedence) CHECK(parser_reduce(&parser, (precedence)))
 
+	const char *cursor = string;
 	while (1) {
-		while (isspace((unsigned char)**string)) {
-			++*string;
+		while (isspace((unsigned char)*cursor)) {
+			++cursor;
 		}
 
-		switch (**string) {
-			case '|':
-			case '+': {
-				++*string;
-
-				expression = boolean_expression_new_operation(
-					boolean_operation_type_disjunction,
-					expression,
-					boolean_expression_from_string_term(string)
+		if (expecting_operand) {
+			if (*cursor == '!') {
+				PUSH_OPERATOR(
+					.type = parser_operator_type_operation,
+					.operation_type = boolean_operation_type_negation,
+					.operands_count = 1,
+					.position = COLUMN(cursor)
 				);
-			} break;
-			default: return expression;
+				++cursor;
+			} else if (*cursor == '(') {
+				PUSH_OPERATOR(.type = parser_operator_type_parenthesis, .position = COLUMN(cursor));
+				++cursor;
+			} else if (isalpha((unsigned char)*cursor)) {
+				PUSH_OPERAND(boolean_expression_new_variable(*cursor));
+				++cursor;
+				expecting_operand = false;
+			} else if (isdigit((unsigned char)*cursor)) {
+				// any non-zero constant is implicitly converted into a 1
+				bool value = false;
+				while (isdigit((unsigned char)*cursor)) {
+					value |= *cursor != '0';
+					++cursor;
+				}
+				PUSH_OPERAND(boolean_expression_new_constant(value));
+				expecting_operand = false;
+			} else if (*cursor == '\0') {
+				FAIL("expected operand at end of expression (column %zu)", COLUMN(cursor));
+			} else {
+				FAIL("expected operand but found '%c' at column %zu", *cursor, COLUMN(cursor));
+			}
+		} else {
+			if (*cursor == '\'') {
+				// postfix negation binds tighter than anything else, so apply it immediately
+				size_t *depth = &parser.depths[parser.operands_count - 1];
+				if (*depth >= BOOLEAN_EXPRESSION_DEPTH_MAXIMUM) {
+					FAIL(
+						"expression nested deeper than %d levels at column %zu",
+						BOOLEAN_EXPRESSION_DEPTH_MAXIMUM,
+						COLUMN(cursor)
+					);
+				}
+				++*depth;
+				struct boolean_expression *operand = &parser.operands[parser.operands_count - 1];
+				*operand =
+					boolean_expression_new_operation(boolean_operation_type_negation, *operand);
+				++cursor;
+			} else if (*cursor == '|' || *cursor == '+') {
+				PUSH_BINARY_OPERATOR(boolean_operation_type_disjunction);
+				++cursor;
+				expecting_operand = true;
+			} else if (*cursor == '^') {
+				PUSH_BINARY_OPERATOR(boolean_operation_type_exclusive_disjunction);
+				++cursor;
+				expecting_operand = true;
+			} else if (*cursor == '&' || *cursor == '*' || *cursor == '!' || *cursor == '(' ||
+					   isalpha((unsigned char)*cursor)) {
+				// juxtaposition is an implicit conjunction, so only consume explicit operators
+				PUSH_BINARY_OPERATOR(boolean_operation_type_conjunction);
+				if (*cursor == '&' || *cursor == '*') {
+					++cursor;
+				}
+				expecting_operand = true;
+			} else if (*cursor == ')') {
+				REDUCE(0);
+				if (parser.operators_count == 0) {
+					FAIL("unmatched ')' at column %zu", COLUMN(cursor));
+				}
+				parser.operators_count--;
+				++cursor;
+			} else if (*cursor == '\0') {
+				REDUCE(0);
+				if (parser.operators_count != 0) {
+					size_t position = parser.operators[parser.operators_count - 1].position;
+					FAIL("unclosed '(' at column %zu", position);
+				}
+				break;
+			} else {
+				FAIL("unexpected character '%c' at column %zu", *cursor, COLUMN(cursor));
+			}
 		}
 	}
-}
 
-struct boolean_expression boolean_expression_from_string(const char *string) {
-	assert(string != NULL);
+#undef REDUCE
+#undef PUSH_BINARY_OPERATOR
+#undef CHECK
+#undef PUSH_OPERATOR
+#undef PUSH_OPERAND
+#undef FAIL
+#undef COLUMN
 
-	struct boolean_expression expression = boolean_expression_from_string_expression(&string);
+	assert(parser.operands_count == 1);
 
-	while (isspace((unsigned char)*string)) {
-		++string;
-	}
+	*expression = parser.operands[0];
+	parser.operands_count = 0;
+	parser_drop(&parser);
 
-	if (*string != '\0') {
-		(void)fprintf(stderr, "Warning: trailing characters \"%s\" after expression\n", string);
-	}
-
-	return expression;
+	return boolean_status_success();
 }
 
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
@@ -327,43 +563,42 @@ static int boolean_expression_to_string_(
 		case boolean_expression_type_operation: {
 			switch (expression->operation.type) {
 				case boolean_operation_type_conjunction:
-				case boolean_operation_type_disjunction: {
-					if (expression->operation.operands[0].type ==
-							boolean_expression_type_operation &&
-						(boolean_operation_type_precedence(
-							 expression->operation.operands[0].operation.type
-						 ) < boolean_operation_type_precedence(expression->operation.type))) {
-						print(snprintf, "(");
-						print(boolean_expression_to_string_, &expression->operation.operands[0]);
-						print(snprintf, ")");
-					} else {
-						print(boolean_expression_to_string_, &expression->operation.operands[0]);
-					}
-
-					switch (expression->operation.type) {
-						case boolean_operation_type_conjunction: {
-							if (expression->operation.operands[0].type ==
-									boolean_expression_type_constant ||
-								expression->operation.operands[1].type ==
-									boolean_expression_type_constant) {
-								print(snprintf, " * ");
+				case boolean_operation_type_disjunction:
+				case boolean_operation_type_exclusive_disjunction: {
+					const struct boolean_expression *operands = expression->operation.operands;
+					for (size_t i = 0; i < expression->operation.operands_count; i++) {
+						if (i != 0) {
+							switch (expression->operation.type) {
+								case boolean_operation_type_conjunction: {
+									if (operands[i - 1].type == boolean_expression_type_constant ||
+										operands[i].type == boolean_expression_type_constant) {
+										print(snprintf, " * ");
+									}
+								} break;
+								case boolean_operation_type_disjunction:
+									print(snprintf, " + ");
+									break;
+								case boolean_operation_type_exclusive_disjunction:
+									print(snprintf, " ^ ");
+									break;
+								// we have already checked the operation's type before
+								default: __builtin_unreachable();
 							}
-						} break;
-						case boolean_operation_type_disjunction: print(snprintf, " + "); break;
-						// we have already checked the operation's type before
-						default: __builtin_unreachable();
-					}
-
-					if (expression->operation.operands[1].type ==
-							boolean_expression_type_operation &&
-						(boolean_operation_type_precedence(
-							 expression->operation.operands[1].operation.type
-						 ) <= boolean_operation_type_precedence(expression->operation.type))) {
-						print(snprintf, "(");
-						print(boolean_expression_to_string_, &expression->operation.operands[1]);
-						print(snprintf, ")");
-					} else {
-						print(boolean_expression_to_string_, &expression->operation.operands[1]);
+						}
+
+						// operands other than the first are parenthesized even on equal precedence,
+						// to preserve the grouping of nested operations
+						if (operands[i].type == boolean_expression_type_operation &&
+							(boolean_operation_type_precedence(operands[i].operation.type) <
+								 boolean_operation_type_precedence(expression->operation.type) ||
+							 (i != 0 &&
+							  operands[i].operation.type == expression->operation.type))) {
+							print(snprintf, "(");
+							print(boolean_expression_to_string_, &operands[i]);
+							print(snprintf, ")");
+						} else {
+							print(boolean_expression_to_string_, &operands[i]);
+						}
 					}
 				} break;
 				case boolean_operation_type_negation: {
@@ -409,34 +644,55 @@ char *boolean_expression_to_string(const struct boolean_expression *expression)
 	return string;
 }
 
-struct boolean_expression boolean_expression_from_minterm(
-	uint64_t minterm,
+struct boolean_expression boolean_expression_from_implicant(
+	struct boolean_implicant implicant,
 	const struct boolean_variables *variables
 ) {
 	assert(variables != NULL);
 
-	struct boolean_expression expression = boolean_expression_new_variable(variables->data[0]);
-	if (((minterm >> (variables->length - 1)) & 1U) == 0) {
-		expression = boolean_expression_new_operation(boolean_operation_type_negation, expression);
+	size_t literals_count = 0;
+	for (size_t index = 0; index < variables->length; index++) {
+		literals_count += (implicant.mask >> (variables->length - index - 1)) & 1U;
 	}
+
+	struct boolean_expression *literals = malloc(literals_count * sizeof(*literals));
+	assert(literals != NULL || literals_count == 0);
+
+	size_t literal = 0;
 	for (size_t index = 0; index < variables->length; index++) {
-		struct boolean_expression boolean_expression_ =
-			boolean_expression_new_variable(variables->data[index]);
-		if (((minterm >> (variables->length - index - 1)) & 1U) == 0) {
-			boolean_expression_ = boolean_expression_new_operation(
+		if (((implicant.mask >> (variables->length - index - 1)) & 1U) == 0) {
+			continue;
+		}
+
+		literals[literal] = boolean_expression_new_variable(variables->data[index]);
+		if (((implicant.value >> (variables->length - index - 1)) & 1U) == 0) {
+			literals[literal] = boolean_expression_new_operation(
 				boolean_operation_type_negation,
-				boolean_expression_
+				literals[literal]
 			);
 		}
-
-		expression = boolean_expression_new_operation(
-			boolean_operation_type_conjunction,
-			expression,
-			boolean_expression_
-		);
+		literal++;
 	}
 
-	return expression;
+	return boolean_expression_new_operation_from_operands(
+		boolean_operation_type_conjunction,
+		literals,
+		literals_count
+	);
+}
+struct boolean_expression boolean_expression_from_minterm(
+	uint64_t minterm,
+	const struct boolean_variables *variables
+) {
+	assert(variables != NULL);
+
+	return boolean_expression_from_implicant(
+		(struct boolean_implicant){
+			.value = minterm,
+			.mask = ~UINT64_C(0),
+		},
+		variables
+	);
 }
 struct boolean_expression boolean_expression_from_minterms(
 	const struct boolean_minterms *minterms,
@@ -444,87 +700,257 @@ struct boolean_expression boolean_expression_from_minterms(
 ) {
 	assert(minterms != NULL && variables != NULL);
 
-	if (minterms->length == 0) {
-		return boolean_expression_new_constant(false);
+	struct boolean_expression *terms = malloc(minterms->length * sizeof(*terms));
+	assert(terms != NULL || minterms->length == 0);
+
+	for (size_t i = 0; i < minterms->length; i++) {
+		terms[i] = boolean_expression_from_minterm(minterms->data[i], variables);
 	}
 
-	struct boolean_expression expression =
-		boolean_expression_from_minterm(minterms->data[0], variables);
-	for (size_t i = 1; i < minterms->length; i++) {
-		expression = boolean_expression_new_operation(
+	return boolean_expression_new_operation_from_operands(
+		boolean_operation_type_disjunction,
+		terms,
+		minterms->length
+	);
+}
+struct boolean_expression boolean_expression_from_implicants(
+	const struct boolean_implicants *implicants,
+	const struct boolean_variables *variables
+) {
+	assert(implicants != NULL && variables != NULL);
+
+	struct boolean_expression *terms = malloc(implicants->length * sizeof(*terms));
+	assert(terms != NULL || implicants->length == 0);
+
+	for (size_t i = 0; i < implicants->length; i++) {
+		terms[i] = boolean_expression_from_implicant(implicants->data[i], variables);
+	}
+
+	return boolean_expression_new_operation_from_operands(
+		boolean_operation_type_disjunction,
+		terms,
+		implicants->length
+	);
+}
+
+struct boolean_expression boolean_expression_from_shared_implicants(
+	const struct boolean_shared_implicants *implicants,
+	size_t output,
+	const struct boolean_variables *variables
+) {
+	assert(implicants != NULL && variables != NULL && output < 64);
+
+	size_t terms_count = 0;
+	for (size_t i = 0; i < implicants->length; i++) {
+		terms_count += (implicants->data[i].outputs >> output) & 1U;
+	}
+
+	struct boolean_expression *terms = malloc(terms_count * sizeof(*terms));
+	assert(terms != NULL || terms_count == 0);
+
+	size_t term = 0;
+	for (size_t i = 0; i < implicants->length; i++) {
+		if ((implicants->data[i].outputs >> output) & 1U) {
+			terms[term++] =
+				boolean_expression_from_implicant(implicants->data[i].implicant, variables);
+		}
+	}
+
+	return boolean_expression_new_operation_from_operands(
+		boolean_operation_type_disjunction,
+		terms,
+		terms_count
+	);
+}
+
+// builds a product of sums from the implicants of the function's complement, each of which is the
+// negation of a sum by De Morgan's laws
+struct boolean_expression boolean_expression_product_of_sums_from_implicants(
+	const struct boolean_implicants *implicants,
+	const struct boolean_variables *variables
+) {
+	assert(implicants != NULL && variables != NULL);
+
+	struct boolean_expression *sums = malloc(implicants->length * sizeof(*sums));
+	assert(sums != NULL || implicants->length == 0);
+
+	for (size_t i = 0; i < implicants->length; i++) {
+		struct boolean_implicant implicant = implicants->data[i];
+
+		size_t literals_count = 0;
+		for (size_t index = 0; index < variables->length; index++) {
+			literals_count += (implicant.mask >> (variables->length - index - 1)) & 1U;
+		}
+
+		struct boolean_expression *literals = malloc(literals_count * sizeof(*literals));
+		assert(literals != NULL || literals_count == 0);
+
+		size_t literal = 0;
+		for (size_t index = 0; index < variables->length; index++) {
+			if (((implicant.mask >> (variables->length - index - 1)) & 1U) == 0) {
+				continue;
+			}
+
+			literals[literal] = boolean_expression_new_variable(variables->data[index]);
+			if (((implicant.value >> (variables->length - index - 1)) & 1U) != 0) {
+				literals[literal] = boolean_expression_new_operation(
+					boolean_operation_type_negation,
+					literals[literal]
+				);
+			}
+			literal++;
+		}
+
+		sums[i] = boolean_expression_new_operation_from_operands(
 			boolean_operation_type_disjunction,
-			expression,
-			boolean_expression_from_minterm(minterms->data[i], variables)
+			literals,
+			literals_count
 		);
 	}
 
-	return expression;
+	return boolean_expression_new_operation_from_operands(
+		boolean_operation_type_conjunction,
+		sums,
+		implicants->length
+	);
 }
 
-struct boolean_expression boolean_expression_from_implicant(
-	struct boolean_implicant implicant,
+static size_t reed_muller_cost(const bool *coefficients, size_t variables_count) {
+	size_t cost = 0;
+	for (size_t i = 0; i < ((size_t)1 << variables_count); i++) {
+		if (coefficients[i]) {
+			cost += (size_t)__builtin_popcountll(i) + 1;
+		}
+	}
+	return cost;
+}
+// switches the polarity of a variable in a fixed-polarity Reed-Muller expansion, as x = x' ^ 1
+// makes every product containing the variable also contribute the same product without it
+static void reed_muller_flip(bool *coefficients, size_t variables_count, size_t variable) {
+	for (size_t i = 0; i < ((size_t)1 << variables_count); i++) {
+		if ((i >> variable) & 1U) {
+			coefficients[i ^ ((size_t)1 << variable)] ^= coefficients[i];
+		}
+	}
+}
+// builds an exclusive-or sum of products, starting from the positive polarity Reed-Muller expansion
+// and greedily flipping the polarity of variables while that reduces its literals and products
+struct boolean_expression boolean_expression_exclusive_sum_of_products_from_minterms(
+	const struct boolean_minterms *minterms,
 	const struct boolean_variables *variables
 ) {
-	assert(variables != NULL);
+	assert(minterms != NULL && variables != NULL);
+	assert(variables->length < sizeof(size_t) * CHAR_BIT);
+
+	size_t variables_count = variables->length;
+	size_t rows_count = (size_t)1 << variables_count;
 
-	size_t index = 0;
-	while (index < variables->length &&
-		   ((implicant.mask >> (variables->length - index - 1)) & 1U) == 0) {
-		index++;
+	bool *coefficients = calloc(rows_count, sizeof(*coefficients));
+	assert(coefficients != NULL);
+
+	for (size_t i = 0; i < minterms->length; i++) {
+		if (minterms->data[i] < rows_count) {
+			coefficients[minterms->data[i]] = true;
+		}
 	}
 
-	if (index >= variables->length) {
-		return boolean_expression_new_constant(true);
+	// the Reed-Muller transform of the truth table
+	for (size_t variable = 0; variable < variables_count; variable++) {
+		for (size_t i = 0; i < rows_count; i++) {
+			if ((i >> variable) & 1U) {
+				coefficients[i] ^= coefficients[i ^ ((size_t)1 << variable)];
+			}
+		}
 	}
 
-	struct boolean_expression expression = boolean_expression_new_variable(variables->data[index]);
-	if (((implicant.value >> (variables->length - index - 1)) & 1U) == 0) {
-		expression = boolean_expression_new_operation(boolean_operation_type_negation, expression);
+	uint64_t polarity = 0;
+	size_t cost = reed_muller_cost(coefficients, variables_count);
+	bool improved = true;
+	while (improved) {
+		improved = false;
+		for (size_t variable = 0; variable < variables_count; variable++) {
+			reed_muller_flip(coefficients, variables_count, variable);
+			size_t flipped_cost = reed_muller_cost(coefficients, variables_count);
+			if (flipped_cost < cost) {
+				cost = flipped_cost;
+				polarity ^= UINT64_C(1) << variable;
+				improved = true;
+			} else {
+				reed_muller_flip(coefficients, variables_count, variable);
+			}
+		}
 	}
-	for (index++; index < variables->length; index++) {
-		if (((implicant.mask >> (variables->length - index - 1)) & 1U) == 0) {
+
+	size_t terms_count = 0;
+	for (size_t i = 0; i < rows_count; i++) {
+		terms_count += coefficients[i];
+	}
+
+	struct boolean_expression *terms = malloc(terms_count * sizeof(*terms));
+	assert(terms != NULL || terms_count == 0);
+
+	size_t term = 0;
+	for (size_t i = 0; i < rows_count; i++) {
+		if (!coefficients[i]) {
 			continue;
 		}
 
-		struct boolean_expression boolean_expression_ =
-			boolean_expression_new_variable(variables->data[index]);
-		if (((implicant.value >> (variables->length - index - 1)) & 1U) == 0) {
-			boolean_expression_ = boolean_expression_new_operation(
-				boolean_operation_type_negation,
-				boolean_expression_
-			);
+		size_t literals_count = (size_t)__builtin_popcountll(i);
+		struct boolean_expression *literals = malloc(literals_count * sizeof(*literals));
+		assert(literals != NULL || literals_count == 0);
+
+		size_t literal = 0;
+		for (size_t index = 0; index < variables_count; index++) {
+			size_t variable = variables_count - index - 1;
+			if (((i >> variable) & 1U) == 0) {
+				continue;
+			}
+
+			literals[literal] = boolean_expression_new_variable(variables->data[index]);
+			if ((polarity >> variable) & 1U) {
+				literals[literal] = boolean_expression_new_operation(
+					boolean_operation_type_negation,
+					literals[literal]
+				);
+			}
+			literal++;
 		}
 
-		expression = boolean_expression_new_operation(
+		terms[term++] = boolean_expression_new_operation_from_operands(
 			boolean_operation_type_conjunction,
-			expression,
-			boolean_expression_
+			literals,
+			literals_count
 		);
 	}
 
-	return expression;
+	free(coefficients);
+
+	qsort(terms, terms_count, sizeof(*terms), boolean_expression_compare_);
+
+	return boolean_expression_new_operation_from_operands(
+		boolean_operation_type_exclusive_disjunction,
+		terms,
+		terms_count
+	);
 }
-struct boolean_expression boolean_expression_from_implicants(
-	const struct boolean_implicants *implicants,
-	const struct boolean_variables *variables
-) {
-	assert(implicants != NULL && variables != NULL);
 
-	if (implicants->length == 0) {
-		return boolean_expression_new_constant(false);
-	}
+// the number of literals in the expression
+size_t boolean_expression_cost(const struct boolean_expression *expression) {
+	assert(expression != NULL);
 
-	struct boolean_expression expression =
-		boolean_expression_from_implicant(implicants->data[0], variables);
-	for (size_t i = 1; i < implicants->length; i++) {
-		expression = boolean_expression_new_operation(
-			boolean_operation_type_disjunction,
-			expression,
-			boolean_expression_from_implicant(implicants->data[i], variables)
-		);
+	switch (expression->type) {
+		case boolean_expression_type_constant: return 0;
+		case boolean_expression_type_variable: return 1;
+		case boolean_expression_type_operation: {
+			size_t cost = 0;
+			for (size_t i = 0; i < expression->operation.operands_count; i++) {
+				cost += boolean_expression_cost(&expression->operation.operands[i]);
+			}
+			return cost;
+		}
 	}
 
-	return expression;
+	return 0;
 }
 
 bool boolean_expression_evaluate(
@@ -543,40 +969,215 @@ bool boolean_expression_evaluate(
 			return boolean_environment_get_variable(environment, expression->variable.name);
 		} break;
 		case boolean_expression_type_operation: {
+			const struct boolean_expression *operands = expression->operation.operands;
 			switch (expression->operation.type) {
 				case boolean_operation_type_conjunction: {
-					bool value = boolean_expression_evaluate(
-						&expression->operation.operands[0],
-						environment
-					);
-					if (!value) {
-						return false;
+					for (size_t i = 0; i < expression->operation.operands_count; i++) {
+						if (!boolean_expression_evaluate(&operands[i], environment)) {
+							return false;
+						}
 					}
-					return boolean_expression_evaluate(
-						&expression->operation.operands[1],
-						environment
-					);
+					return true;
 				}
 				case boolean_operation_type_disjunction: {
-					bool value = boolean_expression_evaluate(
-						&expression->operation.operands[0],
-						environment
-					);
-					if (value) {
-						return true;
+					for (size_t i = 0; i < expression->operation.operands_count; i++) {
+						if (boolean_expression_evaluate(&operands[i], environment)) {
+							return true;
+						}
 					}
-					return boolean_expression_evaluate(
-						&expression->operation.operands[1],
-						environment
-					);
+					return false;
+				}
+				case boolean_operation_type_exclusive_disjunction: {
+					bool value = false;
+					for (size_t i = 0; i < expression->operation.operands_count; i++) {
+						value ^= boolean_expression_evaluate(&operands[i], environment);
+					}
+					return value;
 				}
 				case boolean_operation_type_negation: {
-					return !boolean_expression_evaluate(
-						&expression->operation.operands[0],
-						environment
-					);
+					return !boolean_expression_evaluate(&operands[0], environment);
+				}
+			}
+		} break;
+	}
+
+	return false;
+}
+
+// evaluates the expression over 64 environments at once, the word of each variable holding its
+// value in each environment
+uint64_t boolean_expression_evaluate_word(
+	const struct boolean_expression *expression,
+	const uint64_t *words
+) {
+	assert(expression != NULL && words != NULL);
+
+	switch (expression->type) {
+		case boolean_expression_type_constant: {
+			return expression->constant.value ? UINT64_MAX : 0;
+		} break;
+		case boolean_expression_type_variable: {
+			return words[boolean_environment_variable_index(expression->variable.name)];
+		} break;
+		case boolean_expression_type_operation: {
+			const struct boolean_expression *operands = expression->operation.operands;
+			switch (expression->operation.type) {
+				case boolean_operation_type_conjunction: {
+					uint64_t word = UINT64_MAX;
+					for (size_t i = 0; i < expression->operation.operands_count && word != 0; i++) {
+						word &= boolean_expression_evaluate_word(&operands[i], words);
+					}
+					return word;
+				}
+				case boolean_operation_type_disjunction: {
+					uint64_t word = 0;
+					for (size_t i = 0; i < expression->operation.operands_count &&
+									   word != UINT64_MAX;
+						 i++) {
+						word |= boolean_expression_evaluate_word(&operands[i], words);
+					}
+					return word;
+				}
+				case boolean_operation_type_exclusive_disjunction: {
+					uint64_t word = 0;
+					for (size_t i = 0; i < expression->operation.operands_count; i++) {
+						word ^= boolean_expression_evaluate_word(&operands[i], words);
+					}
+					return word;
+				}
+				case boolean_operation_type_negation: {
+					return ~boolean_expression_evaluate_word(&operands[0], words);
 				}
 			}
 		} break;
 	}
+
+	return 0;
+}
+
+// how many words of environments each node is evaluated over at once, wide enough for the word
+// loops to be vectorized into 256 or 512 bit registers
+#define BATCH_BLOCK_WORDS 8
+// how many words of environments each thread takes at a time
+#define BATCH_CHUNK_WORDS 1024
+
+static void boolean_expression_evaluate_block(
+	const struct boolean_expression *expression,
+	const uint64_t *const *columns,
+	size_t offset,
+	size_t words_count,
+	uint64_t *block
+) {
+	switch (expression->type) {
+		case boolean_expression_type_constant: {
+			uint64_t word = expression->constant.value ? UINT64_MAX : 0;
+			for (size_t i = 0; i < words_count; i++) {
+				block[i] = word;
+			}
+		} break;
+		case boolean_expression_type_variable: {
+			const uint64_t *column =
+				columns[boolean_environment_variable_index(expression->variable.name)];
+			assert(column != NULL);
+			memcpy(block, &column[offset], words_count * sizeof(*block));
+		} break;
+		case boolean_expression_type_operation: {
+			const struct boolean_expression *operands = expression->operation.operands;
+			boolean_expression_evaluate_block(&operands[0], columns, offset, words_count, block);
+
+			uint64_t operand_block[BATCH_BLOCK_WORDS];
+			for (size_t i = 1; i < expression->operation.operands_count; i++) {
+				boolean_expression_evaluate_block(
+					&operands[i],
+					columns,
+					offset,
+					words_count,
+					operand_block
+				);
+				switch (expression->operation.type) {
+					case boolean_operation_type_conjunction: {
+						for (size_t j = 0; j < words_count; j++) {
+							block[j] &= operand_block[j];
+						}
+					} break;
+					case boolean_operation_type_disjunction: {
+						for (size_t j = 0; j < words_count; j++) {
+							block[j] |= operand_block[j];
+						}
+					} break;
+					case boolean_operation_type_exclusive_disjunction: {
+						for (size_t j = 0; j < words_count; j++) {
+							block[j] ^= operand_block[j];
+						}
+					} break;
+					case boolean_operation_type_negation: assert(false); break;
+				}
+			}
+
+			if (expression->operation.type == boolean_operation_type_negation) {
+				for (size_t i = 0; i < words_count; i++) {
+					block[i] = ~block[i];
+				}
+			}
+		} break;
+	}
+}
+
+struct batch {
+	const struct boolean_expression *expression;
+	const uint64_t *const *columns;
+	size_t words_count;
+	uint64_t *results;
+};
+static void boolean_expression_evaluate_chunk(size_t index, void *context) {
+	const struct batch *batch = context;
+
+	size_t end = (index + 1) * BATCH_CHUNK_WORDS;
+	if (end > batch->words_count) {
+		end = batch->words_count;
+	}
+	for (size_t offset = index * BATCH_CHUNK_WORDS; offset < end; offset += BATCH_BLOCK_WORDS) {
+		size_t words_count = end - offset < BATCH_BLOCK_WORDS ? end - offset : BATCH_BLOCK_WORDS;
+		boolean_expression_evaluate_block(
+			batch->expression,
+			batch->columns,
+			offset,
+			words_count,
+			&batch->results[offset]
+		);
+	}
+}
+
+// evaluates the expression over many environments, bit sliced so that bit j of word i of the
+// column of a variable is its value in environment 64 * i + j, with a null column for each
+// variable the expression doesn't use, the results are packed the same way, with the bits past
+// the last environment cleared
+void boolean_expression_evaluate_batch(
+	const struct boolean_expression *expression,
+	const uint64_t *const *columns,
+	size_t environments_count,
+	uint64_t *results,
+	bool parallel
+) {
+	assert(expression != NULL && columns != NULL && (results != NULL || environments_count == 0));
+
+	struct batch batch = {
+		.expression = expression,
+		.columns = columns,
+		.words_count = (environments_count + 63) / 64,
+		.results = results,
+	};
+
+	size_t chunks_count = (batch.words_count + BATCH_CHUNK_WORDS - 1) / BATCH_CHUNK_WORDS;
+	if (parallel && chunks_count > 1) {
+		boolean_parallel_for(chunks_count, boolean_expression_evaluate_chunk, &batch);
+	} else {
+		for (size_t i = 0; i < chunks_count; i++) {
+			boolean_expression_evaluate_chunk(i, &batch);
+		}
+	}
+
+	if (environments_count % 64 != 0) {
+		results[batch.words_count - 1] &= (UINT64_C(1) << (environments_count % 64)) - 1U;
+	}
 }
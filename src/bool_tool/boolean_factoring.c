@@ -0,0 +1,453 @@
+#include <bool_tool/boolean_factoring.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// bounds the kernels tried as divisors of a sum of products, each costing a division of it, so
+// that the kernels tried shrink as the sum grows, the best one found so far being used past it
+#define FACTORING_WORK_MAXIMUM ((size_t)1 << 14)
+
+// the literals are numbered with the positive ones first, literal l being bit l % 64 of the rows
+#define FACTORING_LITERALS_COUNT 128
+
+// a product, by the bits of the rows of the variables it has as positive and negative literals
+struct factoring_cube {
+	uint64_t positive;
+	uint64_t negative;
+};
+struct factoring_cubes {
+	struct factoring_cube *data;
+	size_t length;
+};
+
+static size_t factoring_cube_literals_count(struct factoring_cube cube) {
+	return (size_t)__builtin_popcountll(cube.positive) +
+		   (size_t)__builtin_popcountll(cube.negative);
+}
+static uint64_t factoring_cube_support(struct factoring_cube cube) {
+	return cube.positive | cube.negative;
+}
+static bool factoring_cube_contains(struct factoring_cube cube, struct factoring_cube divisor) {
+	return (divisor.positive & ~cube.positive) == 0 && (divisor.negative & ~cube.negative) == 0;
+}
+static struct factoring_cube factoring_cube_remove(
+	struct factoring_cube cube,
+	struct factoring_cube divisor
+) {
+	return (struct factoring_cube){
+		.positive = cube.positive & ~divisor.positive,
+		.negative = cube.negative & ~divisor.negative,
+	};
+}
+static struct factoring_cube factoring_cube_literal(size_t literal) {
+	return (struct factoring_cube){
+		.positive = literal < 64 ? UINT64_C(1) << literal : 0,
+		.negative = literal < 64 ? 0 : UINT64_C(1) << (literal - 64),
+	};
+}
+// the literals of the cube numbered below the given one
+static struct factoring_cube factoring_cube_below(struct factoring_cube cube, size_t literal) {
+	return (struct factoring_cube){
+		.positive = literal < 64 ? cube.positive & ((UINT64_C(1) << literal) - 1U) : cube.positive,
+		.negative = literal < 64 ? 0 : cube.negative & ((UINT64_C(1) << (literal - 64)) - 1U),
+	};
+}
+static int factoring_cube_compare(const void *cube_1, const void *cube_2) {
+	const struct factoring_cube *factoring_cube_1 = cube_1;
+	const struct factoring_cube *factoring_cube_2 = cube_2;
+
+	if (factoring_cube_1->positive != factoring_cube_2->positive) {
+		return factoring_cube_1->positive < factoring_cube_2->positive ? -1 : 1;
+	}
+	return (factoring_cube_1->negative > factoring_cube_2->negative) -
+		   (factoring_cube_1->negative < factoring_cube_2->negative);
+}
+
+static struct factoring_cubes factoring_cubes_new(size_t capacity) {
+	struct factoring_cubes cubes = {
+		.data = malloc(capacity * sizeof(*cubes.data)),
+		.length = 0,
+	};
+	assert(cubes.data != NULL || capacity == 0);
+	return cubes;
+}
+static void factoring_cubes_drop(struct factoring_cubes *cubes) {
+	free(cubes->data);
+}
+static struct factoring_cubes factoring_cubes_clone(const struct factoring_cubes *cubes) {
+	struct factoring_cubes clone = factoring_cubes_new(cubes->length);
+	memcpy(clone.data, cubes->data, cubes->length * sizeof(*cubes->data));
+	clone.length = cubes->length;
+	return clone;
+}
+static size_t factoring_cubes_literals_count(const struct factoring_cubes *cubes) {
+	size_t literals_count = 0;
+	for (size_t i = 0; i < cubes->length; i++) {
+		literals_count += factoring_cube_literals_count(cubes->data[i]);
+	}
+	return literals_count;
+}
+// the largest product dividing every product
+static struct factoring_cube factoring_cubes_common(const struct factoring_cubes *cubes) {
+	struct factoring_cube common = { .positive = ~UINT64_C(0), .negative = ~UINT64_C(0) };
+	for (size_t i = 0; i < cubes->length; i++) {
+		common.positive &= cubes->data[i].positive;
+		common.negative &= cubes->data[i].negative;
+	}
+	return common;
+}
+
+// divides algebraically, the quotient being the products whose products with every product of
+// the divisor are products of the dividend, sharing no variables with it, and the remainder being
+// the products of the dividend left over
+static void boolean_factoring_divide(
+	const struct factoring_cubes *dividend,
+	const struct factoring_cubes *divisor,
+	struct factoring_cubes *quotient,
+	struct factoring_cubes *remainder
+) {
+	assert(divisor->length != 0);
+
+	// sorted so that the products of the quotient and divisor can be looked up
+	struct factoring_cubes sorted = factoring_cubes_clone(dividend);
+	qsort(sorted.data, sorted.length, sizeof(*sorted.data), factoring_cube_compare);
+	bool *divided = calloc(sorted.length, sizeof(*divided));
+	assert(divided != NULL || sorted.length == 0);
+
+	*quotient = factoring_cubes_new(sorted.length);
+	struct factoring_cube first = divisor->data[0];
+	for (size_t i = 0; i < sorted.length; i++) {
+		if (!factoring_cube_contains(sorted.data[i], first)) {
+			continue;
+		}
+
+		struct factoring_cube candidate = factoring_cube_remove(sorted.data[i], first);
+		bool dividing = true;
+		for (size_t j = 1; j < divisor->length && dividing; j++) {
+			struct factoring_cube product = {
+				.positive = candidate.positive | divisor->data[j].positive,
+				.negative = candidate.negative | divisor->data[j].negative,
+			};
+			dividing = (factoring_cube_support(candidate) &
+						factoring_cube_support(divisor->data[j])) == 0 &&
+					   bsearch(
+						   &product,
+						   sorted.data,
+						   sorted.length,
+						   sizeof(*sorted.data),
+						   factoring_cube_compare
+					   ) != NULL;
+		}
+		if (dividing) {
+			quotient->data[quotient->length++] = candidate;
+		}
+	}
+
+	for (size_t i = 0; i < quotient->length; i++) {
+		for (size_t j = 0; j < divisor->length; j++) {
+			struct factoring_cube product = {
+				.positive = quotient->data[i].positive | divisor->data[j].positive,
+				.negative = quotient->data[i].negative | divisor->data[j].negative,
+			};
+			const struct factoring_cube *found = bsearch(
+				&product,
+				sorted.data,
+				sorted.length,
+				sizeof(*sorted.data),
+				factoring_cube_compare
+			);
+			assert(found != NULL);
+			divided[found - sorted.data] = true;
+		}
+	}
+
+	*remainder = factoring_cubes_new(sorted.length);
+	for (size_t i = 0; i < sorted.length; i++) {
+		if (!divided[i]) {
+			remainder->data[remainder->length++] = sorted.data[i];
+		}
+	}
+
+	free(divided);
+	factoring_cubes_drop(&sorted);
+}
+
+struct factoring_search {
+	const struct factoring_cubes *function;
+	size_t variables_count;
+	struct boolean_budget *budget;
+
+	size_t kernels_count;
+	size_t kernels_maximum;
+	// the kernel saving the most literals when divided by, and how many it saves
+	struct factoring_cubes best;
+	size_t best_saving;
+};
+
+static void boolean_factoring_consider(
+	struct factoring_search *search,
+	const struct factoring_cubes *kernel
+) {
+	search->kernels_count++;
+
+	struct factoring_cubes quotient;
+	struct factoring_cubes remainder;
+	boolean_factoring_divide(search->function, kernel, &quotient, &remainder);
+
+	// writing the products of the quotient and the kernel as their product keeps each literal of
+	// the quotient once instead of once per product of the kernel, and the other way around
+	size_t saving = 0;
+	if (quotient.length != 0) {
+		saving = (kernel->length - 1) * factoring_cubes_literals_count(&quotient) +
+				 (quotient.length - 1) * factoring_cubes_literals_count(kernel);
+	}
+	if (saving > search->best_saving) {
+		factoring_cubes_drop(&search->best);
+		search->best = factoring_cubes_clone(kernel);
+		search->best_saving = saving;
+	}
+
+	factoring_cubes_drop(&remainder);
+	factoring_cubes_drop(&quotient);
+}
+
+// the kernels are the sums left after dividing by a product that no product divides all of, each
+// found once by only dividing by literals in increasing order
+static void boolean_factoring_kernels(
+	struct factoring_search *search,
+	const struct factoring_cubes *cubes,
+	size_t first_literal
+) {
+	for (size_t literal = first_literal; literal < FACTORING_LITERALS_COUNT; literal++) {
+		if (search->kernels_count >= search->kernels_maximum ||
+			boolean_budget_expired(search->budget)) {
+			return;
+		}
+		if (literal % 64 >= search->variables_count) {
+			continue;
+		}
+
+		struct factoring_cube divisor = factoring_cube_literal(literal);
+		size_t count = 0;
+		for (size_t i = 0; i < cubes->length; i++) {
+			count += factoring_cube_contains(cubes->data[i], divisor) ? 1 : 0;
+		}
+		if (count < 2) {
+			continue;
+		}
+
+		struct factoring_cubes quotient = factoring_cubes_new(count);
+		for (size_t i = 0; i < cubes->length; i++) {
+			if (factoring_cube_contains(cubes->data[i], divisor)) {
+				quotient.data[quotient.length++] = factoring_cube_remove(cubes->data[i], divisor);
+			}
+		}
+
+		// a common literal below this one means the kernel was already found through it
+		struct factoring_cube common = factoring_cubes_common(&quotient);
+		if (factoring_cube_literals_count(factoring_cube_below(common, literal)) == 0) {
+			for (size_t i = 0; i < quotient.length; i++) {
+				quotient.data[i] = factoring_cube_remove(quotient.data[i], common);
+			}
+			boolean_factoring_kernels(search, &quotient, literal + 1);
+		}
+		factoring_cubes_drop(&quotient);
+	}
+
+	if (cubes->length >= 2) {
+		boolean_factoring_consider(search, cubes);
+	}
+}
+
+static struct boolean_expression boolean_factoring_product(
+	struct factoring_cube cube,
+	const struct boolean_variables *variables
+) {
+	return boolean_expression_from_implicant(
+		(struct boolean_implicant){
+			.value = cube.positive,
+			.mask = cube.positive | cube.negative,
+		},
+		variables
+	);
+}
+static struct boolean_expression boolean_factoring_sum(
+	const struct factoring_cubes *cubes,
+	const struct boolean_variables *variables
+) {
+	struct boolean_expression *terms = malloc(cubes->length * sizeof(*terms));
+	assert(terms != NULL || cubes->length == 0);
+
+	for (size_t i = 0; i < cubes->length; i++) {
+		terms[i] = boolean_factoring_product(cubes->data[i], variables);
+	}
+
+	return boolean_expression_new_operation_from_operands(
+		boolean_operation_type_disjunction,
+		terms,
+		cubes->length
+	);
+}
+// an operation over both operands, taking in the operands of those of the same type
+static struct boolean_expression boolean_factoring_join(
+	enum boolean_operation_type type,
+	struct boolean_expression operand_1,
+	struct boolean_expression operand_2
+) {
+	struct boolean_expression parts[] = { operand_1, operand_2 };
+	size_t parts_count = sizeof(parts) / sizeof(*parts);
+
+	size_t operands_count = 0;
+	for (size_t i = 0; i < parts_count; i++) {
+		if (parts[i].type == boolean_expression_type_operation && parts[i].operation.type == type) {
+			operands_count += parts[i].operation.operands_count;
+		} else {
+			operands_count++;
+		}
+	}
+
+	struct boolean_expression *operands = malloc(operands_count * sizeof(*operands));
+	assert(operands != NULL);
+	size_t operand = 0;
+	for (size_t i = 0; i < parts_count; i++) {
+		if (parts[i].type == boolean_expression_type_operation && parts[i].operation.type == type) {
+			memcpy(
+				&operands[operand],
+				parts[i].operation.operands,
+				parts[i].operation.operands_count * sizeof(*operands)
+			);
+			operand += parts[i].operation.operands_count;
+			free(parts[i].operation.operands);
+		} else {
+			operands[operand++] = parts[i];
+		}
+	}
+
+	return boolean_expression_new_operation_from_operands(type, operands, operands_count);
+}
+
+// takes out the product common to every product, then divides by the kernel saving the most
+// literals and factors the quotient, the kernel and the remainder in turn
+static struct boolean_expression boolean_factoring_factor(
+	const struct factoring_cubes *cubes,
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget
+) {
+	if (cubes->length <= 1) {
+		return boolean_factoring_sum(cubes, variables);
+	}
+
+	struct factoring_cube common = factoring_cubes_common(cubes);
+	if (factoring_cube_literals_count(common) != 0) {
+		struct factoring_cubes rest = factoring_cubes_new(cubes->length);
+		for (size_t i = 0; i < cubes->length; i++) {
+			rest.data[rest.length++] = factoring_cube_remove(cubes->data[i], common);
+		}
+		struct boolean_expression expression = boolean_factoring_join(
+			boolean_operation_type_conjunction,
+			boolean_factoring_product(common, variables),
+			boolean_factoring_factor(&rest, variables, budget)
+		);
+		factoring_cubes_drop(&rest);
+		return expression;
+	}
+
+	struct factoring_search search = {
+		.function = cubes,
+		.variables_count = variables->length,
+		.budget = budget,
+		.kernels_count = 0,
+		.kernels_maximum = FACTORING_WORK_MAXIMUM / cubes->length + 1,
+		.best = factoring_cubes_new(0),
+		.best_saving = 0,
+	};
+	boolean_factoring_kernels(&search, cubes, 0);
+	if (search.best_saving == 0) {
+		factoring_cubes_drop(&search.best);
+		return boolean_factoring_sum(cubes, variables);
+	}
+
+	struct factoring_cubes quotient;
+	struct factoring_cubes remainder;
+	boolean_factoring_divide(cubes, &search.best, &quotient, &remainder);
+
+	struct boolean_expression expression = boolean_factoring_join(
+		boolean_operation_type_conjunction,
+		boolean_factoring_factor(&quotient, variables, budget),
+		boolean_factoring_factor(&search.best, variables, budget)
+	);
+	if (remainder.length != 0) {
+		expression = boolean_factoring_join(
+			boolean_operation_type_disjunction,
+			expression,
+			boolean_factoring_factor(&remainder, variables, budget)
+		);
+	}
+
+	factoring_cubes_drop(&remainder);
+	factoring_cubes_drop(&quotient);
+	factoring_cubes_drop(&search.best);
+
+	return expression;
+}
+
+// factors the sum of products of the implicants algebraically, treating each literal as a variable
+// of its own, into an expression of several levels with no more literals, once the budget expires
+// the sums left are kept as they are
+struct boolean_expression boolean_expression_factored_from_implicants(
+	const struct boolean_implicants *implicants,
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget,
+	struct boolean_factoring_costs *costs
+) {
+	assert(implicants != NULL && variables != NULL && variables->length < 64);
+
+	uint64_t variables_mask = (UINT64_C(1) << variables->length) - 1U;
+	struct factoring_cubes products = factoring_cubes_new(implicants->length);
+	for (size_t i = 0; i < implicants->length; i++) {
+		uint64_t mask = implicants->data[i].mask & variables_mask;
+		products.data[products.length++] = (struct factoring_cube){
+			.positive = implicants->data[i].value & mask,
+			.negative = ~implicants->data[i].value & mask,
+		};
+	}
+
+	// a repeated product would divide itself, so only the first of each is kept, in order
+	struct factoring_cubes sorted = factoring_cubes_clone(&products);
+	qsort(sorted.data, sorted.length, sizeof(*sorted.data), factoring_cube_compare);
+	bool *kept = calloc(sorted.length, sizeof(*kept));
+	assert(kept != NULL || sorted.length == 0);
+	struct factoring_cubes cubes = factoring_cubes_new(products.length);
+	for (size_t i = 0; i < products.length; i++) {
+		const struct factoring_cube *found = bsearch(
+			&products.data[i],
+			sorted.data,
+			sorted.length,
+			sizeof(*sorted.data),
+			factoring_cube_compare
+		);
+		assert(found != NULL);
+		while (found != sorted.data && factoring_cube_compare(found - 1, found) == 0) {
+			found--;
+		}
+		if (!kept[found - sorted.data]) {
+			kept[found - sorted.data] = true;
+			cubes.data[cubes.length++] = products.data[i];
+		}
+	}
+	free(kept);
+	factoring_cubes_drop(&sorted);
+
+	struct boolean_expression expression = boolean_factoring_factor(&cubes, variables, budget);
+	if (costs != NULL) {
+		costs->sum_of_products = factoring_cubes_literals_count(&products);
+		costs->factored = boolean_expression_cost(&expression);
+	}
+
+	factoring_cubes_drop(&cubes);
+	factoring_cubes_drop(&products);
+
+	return expression;
+}
@@ -1,7 +1,54 @@
 #include <bool_tool/boolean_function.h>
 
 #include <assert.h>
+#include <bool_tool/boolean_factoring.h>
+#include <bool_tool/boolean_implicants.h>
+#include <bool_tool/boolean_npn.h>
+#include <bool_tool/boolean_ordering.h>
+#include <bool_tool/boolean_parallel.h>
+#include <bool_tool/boolean_rewrite.h>
+#include <bool_tool/boolean_sat.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
+static struct boolean_function_cache boolean_function_cache_new(void) {
+	return (struct boolean_function_cache){
+		.variables_cached = false,
+		.minterms_cached = false,
+		.truth_table_cached = false,
+		.prime_implicants_cached = false,
+		.minimal_implicants_cached = false,
+		.bdd_cached = false,
+	};
+}
+static void boolean_function_cache_drop(
+	struct boolean_function_cache *cache,
+	enum boolean_function_representation representation
+) {
+	if (cache->variables_cached) {
+		boolean_variables_drop(&cache->variables);
+	}
+	// minterms given as the representation aren't copied
+	if (cache->minterms_cached && representation == boolean_function_representation_expression) {
+		boolean_minterms_drop(&cache->minterms);
+	}
+	if (cache->truth_table_cached) {
+		free(cache->truth_table);
+	}
+	if (cache->prime_implicants_cached) {
+		boolean_implicants_drop(&cache->prime_implicants);
+	}
+	if (cache->minimal_implicants_cached) {
+		boolean_implicants_drop(&cache->minimal_implicants);
+	}
+	if (cache->bdd_cached) {
+		boolean_bdd_drop(&cache->bdd);
+	}
+}
+
+// the forms derived from the original aren't cloned, as they're computed again when needed
 struct boolean_function boolean_function_clone(const struct boolean_function *function) {
 	assert(function != NULL);
 
@@ -16,12 +63,15 @@ struct boolean_function boolean_function_clone(const struct boolean_function *fu
 			);
 		} break;
 	}
+
+	return (struct boolean_function){ 0 };
 }
 
 struct boolean_function boolean_function_new_expression(struct boolean_expression expression) {
 	return (struct boolean_function){
 		.representation = boolean_function_representation_expression,
 		.expression = expression,
+		.cache = boolean_function_cache_new(),
 	};
 }
 struct boolean_function boolean_function_new_minterms(
@@ -32,6 +82,7 @@ struct boolean_function boolean_function_new_minterms(
 		.representation = boolean_function_representation_minterms,
 		.minterms = minterms,
 		.variables = variables,
+		.cache = boolean_function_cache_new(),
 	};
 }
 
@@ -47,4 +98,1393 @@ void boolean_function_drop(struct boolean_function *function) {
 			boolean_variables_drop(&function->variables);
 		} break;
 	}
+	boolean_function_cache_drop(&function->cache, function->representation);
+}
+
+// checks that the minterms are in range, increasing and without repeats
+static struct boolean_status boolean_function_check_minterms(
+	const struct boolean_minterms *minterms,
+	size_t variables_count
+) {
+	assert(variables_count < 64);
+
+	for (size_t i = 0; i < minterms->length; i++) {
+		if ((minterms->data[i] >> variables_count) != 0) {
+			return boolean_status_failure(
+				"minterm %" PRIu64 " is out of range for %zu variables",
+				minterms->data[i],
+				variables_count
+			);
+		}
+		if (i != 0 && minterms->data[i] <= minterms->data[i - 1]) {
+			return boolean_status_failure(
+				"minterm %" PRIu64 " is repeated or out of order",
+				minterms->data[i]
+			);
+		}
+	}
+
+	return boolean_status_success();
+}
+
+// the variables of an expression are the ones it depends on
+const struct boolean_variables *boolean_function_variables(struct boolean_function *function) {
+	assert(function != NULL);
+
+	if (function->representation == boolean_function_representation_minterms) {
+		return &function->variables;
+	}
+
+	if (!function->cache.variables_cached) {
+		function->cache.variables = boolean_variables_from_expression(&function->expression);
+		function->cache.variables_cached = true;
+	}
+	return &function->cache.variables;
+}
+
+// the minterms over the function's variables, which like the other cached forms are no longer
+// charged to the budget once cached, so computations using them under a budget reserve them again
+struct boolean_status boolean_function_minterms(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	const struct boolean_minterms **minterms
+) {
+	assert(function != NULL && minterms != NULL);
+
+	if (!function->cache.minterms_cached) {
+		switch (function->representation) {
+			case boolean_function_representation_expression: {
+				// listed from the truth table, which is cached along the way
+				const uint64_t *truth_table;
+				struct boolean_status status =
+					boolean_function_truth_table(function, budget, &truth_table);
+				if (status.type != boolean_status_type_success) {
+					return status;
+				}
+
+				size_t variables_count = boolean_function_variables(function)->length;
+				size_t words_count = (((size_t)1 << variables_count) + 63) / 64;
+				size_t length = 0;
+				for (size_t word = 0; word < words_count; word++) {
+					length += (size_t)__builtin_popcountll(truth_table[word]);
+				}
+				if (!boolean_budget_reserve_bytes(budget, length * sizeof(uint64_t))) {
+					return boolean_status_failure(
+						"listing the minterms needs %zu bytes, which exceeds the budget",
+						length * sizeof(uint64_t)
+					);
+				}
+				function->cache.minterms =
+					boolean_minterms_from_truth_table(truth_table, variables_count);
+				boolean_budget_release_bytes(budget, length * sizeof(uint64_t));
+			} break;
+			case boolean_function_representation_minterms: {
+				// the given minterms are used as they are, once they're known to be valid
+				if (function->variables.length >= 64) {
+					return boolean_status_failure(
+						"can't expand a function of %zu variables into minterms",
+						function->variables.length
+					);
+				}
+				struct boolean_status status = boolean_function_check_minterms(
+					&function->minterms,
+					function->variables.length
+				);
+				if (status.type != boolean_status_type_success) {
+					return status;
+				}
+				function->cache.minterms = function->minterms;
+			} break;
+		}
+		function->cache.minterms_cached = true;
+	}
+
+	*minterms = &function->cache.minterms;
+	return boolean_status_success();
+}
+
+// a bit per row, for finding whether the function is true on a row in constant time, an
+// expression is expanded straight into it, without listing its minterms
+struct boolean_status boolean_function_truth_table(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	const uint64_t **truth_table
+) {
+	assert(function != NULL && truth_table != NULL);
+
+	if (!function->cache.truth_table_cached) {
+		size_t variables_count = boolean_function_variables(function)->length;
+		switch (function->representation) {
+			case boolean_function_representation_expression: {
+				struct boolean_status status = boolean_truth_table_from_expression(
+					&function->expression,
+					budget,
+					&function->cache.truth_table
+				);
+				if (status.type != boolean_status_type_success) {
+					return status;
+				}
+			} break;
+			case boolean_function_representation_minterms: {
+				const struct boolean_minterms *minterms;
+				struct boolean_status status =
+					boolean_function_minterms(function, budget, &minterms);
+				if (status.type != boolean_status_type_success) {
+					return status;
+				}
+
+				size_t words_count = (((size_t)1 << variables_count) + 63) / 64;
+				if (!boolean_budget_reserve_bytes(budget, words_count * sizeof(uint64_t))) {
+					return boolean_status_failure(
+						"the truth table of %zu variables exceeds the budget",
+						variables_count
+					);
+				}
+				function->cache.truth_table = calloc(words_count, sizeof(uint64_t));
+				assert(function->cache.truth_table != NULL);
+				for (size_t i = 0; i < minterms->length; i++) {
+					uint64_t minterm = minterms->data[i];
+					function->cache.truth_table[minterm / 64] |= UINT64_C(1) << (minterm % 64);
+				}
+			} break;
+		}
+		size_t words_count = (((size_t)1 << variables_count) + 63) / 64;
+		boolean_budget_release_bytes(budget, words_count * sizeof(uint64_t));
+		function->cache.truth_table_cached = true;
+	}
+
+	*truth_table = function->cache.truth_table;
+	return boolean_status_success();
+}
+
+// the cached implicants are found in the given workspace, if any
+static struct boolean_status boolean_function_prime_implicants_(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	struct boolean_implicants_workspace *workspace,
+	const struct boolean_implicants **implicants
+) {
+	assert(function != NULL && implicants != NULL);
+
+	if (!function->cache.prime_implicants_cached) {
+		const struct boolean_minterms *minterms;
+		struct boolean_status status = boolean_function_minterms(function, budget, &minterms);
+		if (status.type != boolean_status_type_success) {
+			return status;
+		}
+
+		status = boolean_implicants_from_minterms(
+			minterms,
+			boolean_function_variables(function),
+			budget,
+			workspace,
+			&function->cache.prime_implicants
+		);
+		if (status.type != boolean_status_type_success) {
+			return status;
+		}
+		function->cache.prime_implicants_cached = true;
+	}
+
+	*implicants = &function->cache.prime_implicants;
+	return boolean_status_success();
+}
+struct boolean_status boolean_function_prime_implicants(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	const struct boolean_implicants **implicants
+) {
+	return boolean_function_prime_implicants_(function, budget, NULL, implicants);
+}
+
+static struct boolean_status boolean_function_minimal_implicants_(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	struct boolean_implicants_workspace *workspace,
+	const struct boolean_implicants **implicants
+) {
+	assert(function != NULL && implicants != NULL);
+
+	if (!function->cache.minimal_implicants_cached) {
+		const struct boolean_implicants *prime_implicants;
+		struct boolean_status status =
+			boolean_function_prime_implicants_(function, budget, workspace, &prime_implicants);
+		if (status.type != boolean_status_type_success) {
+			return status;
+		}
+
+		// the copy the cover is chosen from counts as implicants made, and its bytes are charged
+		// until it's cached
+		size_t bytes = prime_implicants->length * sizeof(*prime_implicants->data);
+		if (!boolean_budget_reserve_implicants(budget, prime_implicants->length)) {
+			return boolean_status_failure(
+				"copying %zu prime implicants exceeds the budget",
+				prime_implicants->length
+			);
+		}
+		if (!boolean_budget_reserve_bytes(budget, bytes)) {
+			return boolean_status_failure(
+				"copying the prime implicants needs %zu bytes, which exceeds the budget",
+				bytes
+			);
+		}
+
+		struct boolean_implicants minimal_implicants = {
+			.data = malloc(prime_implicants->length * sizeof(*minimal_implicants.data)),
+			.length = prime_implicants->length,
+			.capacity = prime_implicants->length,
+		};
+		assert(minimal_implicants.data != NULL || minimal_implicants.length == 0);
+		if (prime_implicants->length != 0) {
+			memcpy(
+				minimal_implicants.data,
+				prime_implicants->data,
+				prime_implicants->length * sizeof(*minimal_implicants.data)
+			);
+		}
+
+		const struct boolean_minterms *minterms;
+		status = boolean_function_minterms(function, budget, &minterms);
+		assert(status.type == boolean_status_type_success);
+		status = boolean_implicants_minimalize(&minimal_implicants, minterms, budget, workspace);
+		boolean_budget_release_bytes(budget, bytes);
+		if (status.type != boolean_status_type_success) {
+			boolean_implicants_drop(&minimal_implicants);
+			return status;
+		}
+		function->cache.minimal_implicants = minimal_implicants;
+		function->cache.minimal_implicants_cached = true;
+	}
+
+	*implicants = &function->cache.minimal_implicants;
+	return boolean_status_success();
+}
+// a subset of the prime implicants that still covers every minterm
+struct boolean_status boolean_function_minimal_implicants(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	const struct boolean_implicants **implicants
+) {
+	return boolean_function_minimal_implicants_(function, budget, NULL, implicants);
+}
+
+// builds the diagram of the minterms that share their first bits, the ones of the variables above
+// the given level, which are consecutive as the minterms are sorted
+static uint32_t boolean_function_bdd_from_minterms(
+	struct boolean_bdd *bdd,
+	const uint64_t *minterms,
+	size_t minterms_count,
+	size_t level
+) {
+	size_t variables_count = bdd->variables.length;
+	if (minterms_count == 0) {
+		return BOOLEAN_BDD_FALSE;
+	}
+	if (level == variables_count) {
+		return BOOLEAN_BDD_TRUE;
+	}
+
+	// the first minterm where the variable at this level is true
+	uint64_t bit = UINT64_C(1) << (variables_count - 1 - level);
+	size_t split = 0;
+	while (split < minterms_count && (minterms[split] & bit) == 0) {
+		split++;
+	}
+
+	uint32_t low = boolean_function_bdd_from_minterms(bdd, minterms, split, level + 1);
+	uint32_t high = boolean_function_bdd_from_minterms(
+		bdd,
+		&minterms[split],
+		minterms_count - split,
+		level + 1
+	);
+
+	// low ^ (variable & (low ^ high)) is high where the variable is true and low elsewhere
+	uint32_t variable = boolean_bdd_variable(bdd, bdd->variables.data[level]);
+	uint32_t difference =
+		boolean_bdd_apply(bdd, boolean_operation_type_exclusive_disjunction, low, high);
+	return boolean_bdd_apply(
+		bdd,
+		boolean_operation_type_exclusive_disjunction,
+		low,
+		boolean_bdd_apply(bdd, boolean_operation_type_conjunction, variable, difference)
+	);
+}
+
+// the diagram of an expression starts out ordered to keep the variables that interact together,
+// that of minterms in the order of their variables, and is then sifted, once built it's no longer
+// charged to the budget
+struct boolean_status boolean_function_bdd(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	const struct boolean_bdd **bdd,
+	uint32_t *node
+) {
+	assert(function != NULL && bdd != NULL && node != NULL);
+
+	if (!function->cache.bdd_cached) {
+		struct boolean_bdd diagram;
+		uint32_t root = BOOLEAN_BDD_FALSE;
+		switch (function->representation) {
+			case boolean_function_representation_expression: {
+				struct boolean_variables order =
+					boolean_variables_order_from_expression(&function->expression);
+				diagram = boolean_bdd_new(&order, budget);
+				boolean_variables_drop(&order);
+
+				struct boolean_status status =
+					boolean_bdd_from_expression(&diagram, &function->expression, &root);
+				if (status.type != boolean_status_type_success) {
+					boolean_bdd_drop(&diagram);
+					return status;
+				}
+			} break;
+			case boolean_function_representation_minterms: {
+				if (function->variables.length >= 64) {
+					return boolean_status_failure(
+						"can't build the decision diagram of a function of %zu variables",
+						function->variables.length
+					);
+				}
+				struct boolean_status status = boolean_function_check_minterms(
+					&function->minterms,
+					function->variables.length
+				);
+				if (status.type != boolean_status_type_success) {
+					return status;
+				}
+
+				diagram = boolean_bdd_new(&function->variables, budget);
+				root = boolean_function_bdd_from_minterms(
+					&diagram,
+					function->minterms.data,
+					function->minterms.length,
+					0
+				);
+				if (diagram.exhausted) {
+					boolean_bdd_drop(&diagram);
+					return boolean_status_failure(
+						"the decision diagram of %zu minterms doesn't fit in the budget",
+						function->minterms.length
+					);
+				}
+			} break;
+		}
+
+		// sifting only improves on the order, so if it runs out of budget the diagram is kept in
+		// the best order it found
+		struct boolean_status status = boolean_bdd_sift(&diagram, &root, budget);
+		boolean_status_drop(&status);
+
+		boolean_budget_release_bytes(diagram.budget, diagram.reserved_bytes);
+		diagram.budget = NULL;
+		diagram.reserved_bytes = 0;
+
+		function->cache.bdd = diagram;
+		function->cache.bdd_node = root;
+		function->cache.bdd_cached = true;
+	}
+
+	*bdd = &function->cache.bdd;
+	*node = function->cache.bdd_node;
+	return boolean_status_success();
+}
+
+// above this many variables, expressions aren't expanded into a truth table at all
+#define TRUTH_TABLE_VARIABLES_MAXIMUM 24
+
+// above this many variables, no exclusive-or sum of products is computed, as its transform is
+// quadratic in the number of variables over the whole truth table
+#define EXCLUSIVE_SUM_OF_PRODUCTS_VARIABLES_MAXIMUM 16
+
+struct boolean_function_forms {
+	// the function the minterms are of, whose cache the sum of products is found through, if any
+	struct boolean_function *function;
+	const struct boolean_minterms *minterms;
+	const struct boolean_variables *variables;
+	struct boolean_budget *budget;
+	struct boolean_implicants_workspace *workspaces;
+	struct boolean_expression sum_of_products;
+	struct boolean_expression factored_sum_of_products;
+	struct boolean_expression product_of_sums;
+	bool product_of_sums_found;
+};
+// the minterms themselves as implicants, for when not even the prime implicants fit in the budget
+static struct boolean_implicants boolean_function_minterm_implicants(
+	const struct boolean_minterms *minterms,
+	const struct boolean_variables *variables
+) {
+	struct boolean_implicants implicants = {
+		.data = malloc(minterms->length * sizeof(*implicants.data)),
+		.length = minterms->length,
+		.capacity = minterms->length,
+	};
+	assert(implicants.data != NULL || implicants.length == 0);
+	for (size_t i = 0; i < minterms->length; i++) {
+		implicants.data[i] = (struct boolean_implicant){
+			.value = minterms->data[i],
+			.mask = (UINT64_C(1) << variables->length) - 1U,
+		};
+	}
+
+	return implicants;
+}
+// the prime implicants of the minterms, or all of them if no cover fits in the budget, or the
+// minterms themselves if not even the prime implicants do
+static struct boolean_implicants boolean_function_implicants(
+	const struct boolean_minterms *minterms,
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget,
+	struct boolean_implicants_workspace *workspace
+) {
+	struct boolean_implicants implicants;
+	struct boolean_status status =
+		boolean_implicants_from_minterms(minterms, variables, budget, workspace, &implicants);
+	if (status.type != boolean_status_type_success) {
+		boolean_status_drop(&status);
+		return boolean_function_minterm_implicants(minterms, variables);
+	}
+
+	status = boolean_implicants_minimalize(&implicants, minterms, budget, workspace);
+	boolean_status_drop(&status);
+
+	return implicants;
+}
+// the same as boolean_function_implicants, but through the cache of the function, so they're kept
+// for whoever asks for them next, the minterms being put in the fallback if they're used
+static const struct boolean_implicants *boolean_function_cover(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	struct boolean_implicants_workspace *workspace,
+	struct boolean_implicants *fallback
+) {
+	const struct boolean_implicants *prime_implicants;
+	struct boolean_status status =
+		boolean_function_prime_implicants_(function, budget, workspace, &prime_implicants);
+	if (status.type != boolean_status_type_success) {
+		boolean_status_drop(&status);
+
+		const struct boolean_minterms *minterms;
+		status = boolean_function_minterms(function, budget, &minterms);
+		assert(status.type == boolean_status_type_success);
+		*fallback =
+			boolean_function_minterm_implicants(minterms, boolean_function_variables(function));
+		return fallback;
+	}
+
+	const struct boolean_implicants *minimal_implicants;
+	status = boolean_function_minimal_implicants_(function, budget, workspace, &minimal_implicants);
+	if (status.type != boolean_status_type_success) {
+		boolean_status_drop(&status);
+		return prime_implicants;
+	}
+
+	return minimal_implicants;
+}
+static void boolean_function_simplify_form(size_t index, void *context) {
+	struct boolean_function_forms *forms = context;
+
+	switch (index) {
+		case 0: {
+			struct boolean_implicants owned_implicants = boolean_implicants_new();
+			const struct boolean_implicants *implicants = &owned_implicants;
+			if (forms->function != NULL) {
+				implicants = boolean_function_cover(
+					forms->function,
+					forms->budget,
+					&forms->workspaces[0],
+					&owned_implicants
+				);
+			} else {
+				owned_implicants = boolean_function_implicants(
+					forms->minterms,
+					forms->variables,
+					forms->budget,
+					&forms->workspaces[0]
+				);
+			}
+
+			forms->sum_of_products =
+				boolean_expression_from_implicants(implicants, forms->variables);
+			forms->factored_sum_of_products = boolean_expression_factored_from_implicants(
+				implicants,
+				forms->variables,
+				forms->budget,
+				NULL
+			);
+			boolean_implicants_drop(&owned_implicants);
+		} break;
+		case 1: {
+			// the complement is as large as the truth table when the function is sparse, so it's
+			// skipped when that doesn't fit in the budget
+			size_t rows = (size_t)1 << forms->variables->length;
+			size_t complement_bytes = (rows - forms->minterms->length) * sizeof(uint64_t);
+			if (!boolean_budget_reserve_bytes(forms->budget, complement_bytes)) {
+				break;
+			}
+
+			// the minimal sum of products of the complement is a minimal product of sums negated
+			struct boolean_minterms complement =
+				boolean_minterms_complement(forms->minterms, forms->variables->length);
+
+			struct boolean_implicants implicants = boolean_function_implicants(
+				&complement,
+				forms->variables,
+				forms->budget,
+				&forms->workspaces[1]
+			);
+			boolean_minterms_drop(&complement);
+			boolean_budget_release_bytes(forms->budget, complement_bytes);
+
+			forms->product_of_sums =
+				boolean_expression_product_of_sums_from_implicants(&implicants, forms->variables);
+			forms->product_of_sums_found = true;
+			boolean_implicants_drop(&implicants);
+		} break;
+		default: assert(false);
+	}
+}
+// computes the sum of products, its factored form, the product of sums and the exclusive-or sum of
+// products forms of the function, and keeps the one with the fewest literals, the function the
+// minterms were taken from, if given, caching its implicants
+static struct boolean_expression boolean_function_simplify_minterms(
+	struct boolean_simplifier *simplifier,
+	struct boolean_function *function,
+	const struct boolean_minterms *minterms,
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget,
+	bool parallel
+) {
+	assert(simplifier != NULL && minterms != NULL && variables != NULL);
+	assert(variables->length < 64);
+
+	struct boolean_function_forms forms = {
+		.function = function,
+		.minterms = minterms,
+		.variables = variables,
+		.budget = budget,
+		.workspaces = simplifier->workspaces,
+		.product_of_sums_found = false,
+	};
+	if (parallel) {
+		boolean_parallel_for(2, boolean_function_simplify_form, &forms);
+	} else {
+		boolean_function_simplify_form(0, &forms);
+		boolean_function_simplify_form(1, &forms);
+	}
+
+	struct boolean_expression expression = forms.sum_of_products;
+	size_t cost = boolean_expression_cost(&expression);
+
+	// ties are kept in sum of products form, as it's the most conventional
+	if (boolean_expression_cost(&forms.factored_sum_of_products) < cost) {
+		boolean_expression_drop(&expression);
+		expression = forms.factored_sum_of_products;
+		cost = boolean_expression_cost(&expression);
+	} else {
+		boolean_expression_drop(&forms.factored_sum_of_products);
+	}
+	if (forms.product_of_sums_found) {
+		if (boolean_expression_cost(&forms.product_of_sums) < cost) {
+			boolean_expression_drop(&expression);
+			expression = forms.product_of_sums;
+			cost = boolean_expression_cost(&expression);
+		} else {
+			boolean_expression_drop(&forms.product_of_sums);
+		}
+	}
+
+	size_t coefficients_bytes = (size_t)1 << variables->length;
+	if (variables->length <= EXCLUSIVE_SUM_OF_PRODUCTS_VARIABLES_MAXIMUM &&
+		!boolean_budget_expired(budget) &&
+		boolean_budget_reserve_bytes(budget, coefficients_bytes)) {
+		struct boolean_expression exclusive_sum_of_products =
+			boolean_expression_exclusive_sum_of_products_from_minterms(minterms, variables);
+		boolean_budget_release_bytes(budget, coefficients_bytes);
+
+		if (boolean_expression_cost(&exclusive_sum_of_products) < cost) {
+			boolean_expression_drop(&expression);
+			expression = exclusive_sum_of_products;
+		} else {
+			boolean_expression_drop(&exclusive_sum_of_products);
+		}
+	}
+
+	return expression;
+}
+
+static size_t union_find_root(size_t *parents, size_t index) {
+	while (parents[index] != index) {
+		parents[index] = parents[parents[index]];
+		index = parents[index];
+	}
+	return index;
+}
+// splits a conjunction or disjunction into operations of the same type over groups of its operands
+// with pairwise disjoint supports, returning the number of groups, or zero if it doesn't split
+static size_t boolean_expression_decompose(
+	struct boolean_expression *expression,
+	struct boolean_expression **components
+) {
+	assert(expression != NULL && components != NULL);
+
+	if (expression->type != boolean_expression_type_operation ||
+		expression->operation.type == boolean_operation_type_negation) {
+		return 0;
+	}
+
+	struct boolean_expression *operands = expression->operation.operands;
+	size_t operands_count = expression->operation.operands_count;
+
+	size_t *parents = malloc(operands_count * sizeof(*parents));
+	size_t *indices = malloc(operands_count * sizeof(*indices));
+	assert(parents != NULL && indices != NULL);
+
+	// operands sharing a variable are joined through the first operand that used it
+	size_t owners[BOOLEAN_ENVIRONMENT_VARIABLES_COUNT];
+	for (size_t i = 0; i < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT; i++) {
+		owners[i] = SIZE_MAX;
+	}
+	for (size_t i = 0; i < operands_count; i++) {
+		parents[i] = i;
+
+		struct boolean_environment support = boolean_environment_new();
+		boolean_variables_from_expression_(&operands[i], &support);
+		for (size_t j = 0; j < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT; j++) {
+			if (((support.variables >> j) & 1U) == 0) {
+				continue;
+			}
+			if (owners[j] == SIZE_MAX) {
+				owners[j] = i;
+			} else {
+				parents[union_find_root(parents, i)] = union_find_root(parents, owners[j]);
+			}
+		}
+	}
+
+	size_t components_count = 0;
+	for (size_t i = 0; i < operands_count; i++) {
+		if (union_find_root(parents, i) == i) {
+			indices[i] = components_count++;
+		}
+	}
+
+	if (components_count <= 1) {
+		free(indices);
+		free(parents);
+		return 0;
+	}
+
+	size_t *counts = calloc(components_count, sizeof(*counts));
+	assert(counts != NULL);
+	for (size_t i = 0; i < operands_count; i++) {
+		counts[indices[union_find_root(parents, i)]]++;
+	}
+
+	struct boolean_expression **groups = malloc(components_count * sizeof(*groups));
+	assert(groups != NULL);
+	for (size_t i = 0; i < components_count; i++) {
+		groups[i] = malloc(counts[i] * sizeof(*groups[i]));
+		assert(groups[i] != NULL);
+		counts[i] = 0;
+	}
+	for (size_t i = 0; i < operands_count; i++) {
+		size_t component = indices[union_find_root(parents, i)];
+		groups[component][counts[component]++] = operands[i];
+	}
+
+	*components = malloc(components_count * sizeof(**components));
+	assert(*components != NULL);
+	for (size_t i = 0; i < components_count; i++) {
+		(*components)[i] = boolean_expression_new_operation_from_operands(
+			expression->operation.type,
+			groups[i],
+			counts[i]
+		);
+	}
+
+	free(groups);
+	free(counts);
+	free(indices);
+	free(parents);
+	free(operands);
+
+	return components_count;
+}
+
+// the literals of a product, as literals of the solver, or false if it isn't a product
+static bool boolean_function_product_literals(
+	const struct boolean_expression *product,
+	const int *variables,
+	int *literals,
+	size_t *literals_count
+) {
+	const struct boolean_expression *operands = product;
+	size_t operands_count = 1;
+	if (product->type == boolean_expression_type_operation &&
+		product->operation.type == boolean_operation_type_conjunction) {
+		operands = product->operation.operands;
+		operands_count = product->operation.operands_count;
+	}
+
+	*literals_count = 0;
+	for (size_t i = 0; i < operands_count; i++) {
+		const struct boolean_expression *literal = &operands[i];
+		int sign = 1;
+		if (literal->type == boolean_expression_type_operation &&
+			literal->operation.type == boolean_operation_type_negation) {
+			literal = &literal->operation.operands[0];
+			sign = -1;
+		}
+		if (literal->type != boolean_expression_type_variable) {
+			return false;
+		}
+
+		size_t index = boolean_environment_variable_index(literal->variable.name);
+		literals[(*literals_count)++] = sign * variables[index];
+	}
+
+	return true;
+}
+static struct boolean_expression boolean_function_product_from_literals(
+	const int *literals,
+	size_t literals_count,
+	const char *names
+) {
+	struct boolean_expression *operands = malloc(literals_count * sizeof(*operands));
+	assert(operands != NULL || literals_count == 0);
+
+	for (size_t i = 0; i < literals_count; i++) {
+		operands[i] = boolean_expression_new_variable(names[abs(literals[i])]);
+		if (literals[i] < 0) {
+			operands[i] =
+				boolean_expression_new_operation(boolean_operation_type_negation, operands[i]);
+		}
+	}
+
+	return boolean_expression_new_operation_from_operands(
+		boolean_operation_type_conjunction,
+		operands,
+		literals_count
+	);
+}
+// with too many variables for a truth table, a sum of products is made prime and irredundant
+// directly, by asking a SAT solver whether each literal is needed for its product to stay an
+// implicant, then whether each product is essential to the cover of the others
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+static void boolean_function_simplify_sum_of_products(
+	struct boolean_expression *expression,
+	struct boolean_budget *budget
+) {
+	if (expression->type != boolean_expression_type_operation ||
+		expression->operation.type != boolean_operation_type_disjunction) {
+		return;
+	}
+
+	struct boolean_expression *products = expression->operation.operands;
+	size_t products_count = expression->operation.operands_count;
+
+	struct boolean_sat sat = boolean_sat_new();
+
+	// the expression's variables are created before any of the encoding's own, so they're small
+	// enough to index the names with
+	int variables[BOOLEAN_ENVIRONMENT_VARIABLES_COUNT] = { 0 };
+	char names[BOOLEAN_ENVIRONMENT_VARIABLES_COUNT + 1] = { 0 };
+	struct boolean_environment support = boolean_environment_new();
+	boolean_variables_from_expression_(expression, &support);
+	for (size_t i = 0; i < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT; i++) {
+		if (((support.variables >> i) & 1U) != 0) {
+			variables[i] = boolean_sat_new_variable(&sat);
+			names[variables[i]] = boolean_environment_variable_name(i);
+		}
+	}
+
+	struct {
+		int *data;
+		size_t length;
+	} *cubes = malloc(products_count * sizeof(*cubes));
+	// the assumptions are a cube's literals followed by the negations of products
+	int *assumptions =
+		malloc((BOOLEAN_ENVIRONMENT_VARIABLES_COUNT + products_count) * sizeof(*assumptions));
+	int *outputs = malloc(products_count * sizeof(*outputs));
+	bool *kept = malloc(products_count * sizeof(*kept));
+	assert(cubes != NULL && assumptions != NULL && outputs != NULL && kept != NULL);
+
+	bool products_only = true;
+	for (size_t i = 0; i < products_count; i++) {
+		cubes[i].data = malloc(BOOLEAN_ENVIRONMENT_VARIABLES_COUNT * sizeof(*cubes[i].data));
+		assert(cubes[i].data != NULL);
+		products_only &= boolean_function_product_literals(
+			&products[i],
+			variables,
+			cubes[i].data,
+			&cubes[i].length
+		);
+	}
+	if (!products_only) {
+		goto cleanup;
+	}
+
+	// the function is encoded as the disjunction of the original products, which it stays equal
+	// to as literals are dropped
+	for (size_t i = 0; i < products_count; i++) {
+		outputs[i] = boolean_sat_add_expression(&sat, &products[i], variables);
+	}
+
+	// every check that's made is final, so running out of budget only stops further ones
+	bool budget_left = true;
+
+	// a literal can be dropped if the product without it still implies the function
+	for (size_t i = 0; i < products_count && budget_left; i++) {
+		for (size_t j = 0; j < cubes[i].length && budget_left;) {
+			size_t assumptions_count = 0;
+			for (size_t k = 0; k < cubes[i].length; k++) {
+				if (k != j) {
+					assumptions[assumptions_count++] = cubes[i].data[k];
+				}
+			}
+			for (size_t k = 0; k < products_count; k++) {
+				assumptions[assumptions_count++] = -outputs[k];
+			}
+
+			switch (boolean_sat_solve(&sat, assumptions, assumptions_count, budget)) {
+				case boolean_sat_result_unsatisfiable: {
+					cubes[i].data[j] = cubes[i].data[--cubes[i].length];
+				} break;
+				case boolean_sat_result_satisfiable: j++; break;
+				case boolean_sat_result_unknown: budget_left = false; break;
+			}
+		}
+	}
+
+	// a product can be dropped if the others cover it, the ones with the most literals going first
+	for (size_t i = 0; i < products_count; i++) {
+		kept[i] = true;
+
+		struct boolean_expression cube =
+			boolean_function_product_from_literals(cubes[i].data, cubes[i].length, names);
+		outputs[i] = boolean_sat_add_expression(&sat, &cube, variables);
+		boolean_expression_drop(&cube);
+	}
+	for (size_t length = BOOLEAN_ENVIRONMENT_VARIABLES_COUNT + 1; length-- > 0 && budget_left;) {
+		for (size_t i = 0; i < products_count && budget_left; i++) {
+			if (cubes[i].length != length) {
+				continue;
+			}
+
+			size_t assumptions_count = 0;
+			for (size_t k = 0; k < cubes[i].length; k++) {
+				assumptions[assumptions_count++] = cubes[i].data[k];
+			}
+			for (size_t k = 0; k < products_count; k++) {
+				if (k != i && kept[k]) {
+					assumptions[assumptions_count++] = -outputs[k];
+				}
+			}
+
+			switch (boolean_sat_solve(&sat, assumptions, assumptions_count, budget)) {
+				case boolean_sat_result_unsatisfiable: kept[i] = false; break;
+				case boolean_sat_result_satisfiable: break;
+				case boolean_sat_result_unknown: budget_left = false; break;
+			}
+		}
+	}
+
+	struct boolean_expression *operands = malloc(products_count * sizeof(*operands));
+	assert(operands != NULL);
+	size_t operands_count = 0;
+	for (size_t i = 0; i < products_count; i++) {
+		if (kept[i]) {
+			operands[operands_count++] =
+				boolean_function_product_from_literals(cubes[i].data, cubes[i].length, names);
+		}
+	}
+
+	boolean_expression_drop(expression);
+	*expression = boolean_expression_new_operation_from_operands(
+		boolean_operation_type_disjunction,
+		operands,
+		operands_count
+	);
+	boolean_expression_rewrite(expression);
+
+cleanup:
+	for (size_t i = 0; i < products_count; i++) {
+		free(cubes[i].data);
+	}
+	free(kept);
+	free(outputs);
+	free(assumptions);
+	free(cubes);
+	boolean_sat_drop(&sat);
+}
+
+struct boolean_function_components {
+	struct boolean_expression *expressions;
+	struct boolean_simplifier *simplifiers;
+	struct boolean_budget *budget;
+};
+static struct boolean_expression boolean_function_simplify_expression(
+	struct boolean_simplifier *simplifier,
+	struct boolean_function *function,
+	struct boolean_expression expression,
+	struct boolean_budget *budget,
+	bool parallel
+);
+static void boolean_function_simplify_component(size_t index, void *context) {
+	struct boolean_function_components *components = context;
+	components->expressions[index] = boolean_function_simplify_expression(
+		&components->simplifiers[index],
+		NULL,
+		components->expressions[index],
+		components->budget,
+		false
+	);
+}
+// if the expression is too large to expand within the budget, it's returned only rewritten, the
+// function it was cloned from, if given, has its minterms and implicants cached when the rewritten
+// expression still depends on all of its variables
+static struct boolean_expression boolean_function_simplify_expression(
+	struct boolean_simplifier *simplifier,
+	struct boolean_function *function,
+	struct boolean_expression expression,
+	struct boolean_budget *budget,
+	bool parallel
+) {
+	// cheap algebraic rewrites first, as every variable they eliminate halves the size of the truth
+	// table
+	boolean_expression_rewrite(&expression);
+
+	// a sum of products where no variable appears twice is already minimal
+	if (boolean_expression_is_read_once_sum_of_products(&expression)) {
+		return expression;
+	}
+
+	// operands with disjoint supports can be minimized independently, which turns a truth table
+	// over the union of their variables into one small truth table per group
+	enum boolean_operation_type type = expression.operation.type;
+	struct boolean_function_components components = {
+		.expressions = NULL,
+		.simplifiers = NULL,
+		.budget = budget,
+	};
+	size_t components_count = boolean_expression_decompose(&expression, &components.expressions);
+	if (components_count != 0) {
+		// each component gets its own simplifier, as they may be simplified at the same time
+		if (components_count > simplifier->components_count) {
+			simplifier->components = realloc(
+				simplifier->components,
+				components_count * sizeof(*simplifier->components)
+			);
+			assert(simplifier->components != NULL);
+			for (size_t i = simplifier->components_count; i < components_count; i++) {
+				simplifier->components[i] = boolean_simplifier_new();
+			}
+			simplifier->components_count = components_count;
+		}
+		components.simplifiers = simplifier->components;
+
+		if (parallel) {
+			boolean_parallel_for(
+				components_count,
+				boolean_function_simplify_component,
+				&components
+			);
+		} else {
+			for (size_t i = 0; i < components_count; i++) {
+				boolean_function_simplify_component(i, &components);
+			}
+		}
+
+		// flattens the minimized components back into a single operation
+		expression = boolean_expression_new_operation_from_operands(
+			type,
+			components.expressions,
+			components_count
+		);
+		boolean_expression_rewrite(&expression);
+
+		return expression;
+	}
+
+	struct boolean_environment support = boolean_environment_new();
+	boolean_variables_from_expression_(&expression, &support);
+	size_t variables_count = (size_t)__builtin_popcountll(support.variables);
+	if (variables_count > TRUTH_TABLE_VARIABLES_MAXIMUM) {
+		boolean_function_simplify_sum_of_products(&expression, budget);
+		return expression;
+	}
+
+	// the rewrites never add variables, so the expression is over the same ones as the function if
+	// it's over as many
+	if (function != NULL && boolean_function_variables(function)->length == variables_count) {
+		const struct boolean_minterms *minterms;
+		struct boolean_status status = boolean_function_minterms(function, budget, &minterms);
+		size_t minterms_bytes = 0;
+		if (status.type == boolean_status_type_success) {
+			minterms_bytes = minterms->length * sizeof(*minterms->data);
+			if (!boolean_budget_reserve_bytes(budget, minterms_bytes)) {
+				status = boolean_status_failure("the minterms exceed the budget");
+			}
+		}
+		if (status.type != boolean_status_type_success) {
+			boolean_status_drop(&status);
+			boolean_function_simplify_sum_of_products(&expression, budget);
+			return expression;
+		}
+
+		boolean_expression_drop(&expression);
+		expression = boolean_function_simplify_minterms(
+			simplifier,
+			function,
+			minterms,
+			boolean_function_variables(function),
+			budget,
+			parallel
+		);
+		boolean_budget_release_bytes(budget, minterms_bytes);
+
+		return expression;
+	}
+
+	struct boolean_minterms minterms;
+	struct boolean_status status = boolean_minterms_from_expression(&expression, budget, &minterms);
+	if (status.type != boolean_status_type_success) {
+		boolean_status_drop(&status);
+		boolean_function_simplify_sum_of_products(&expression, budget);
+		return expression;
+	}
+
+	struct boolean_variables variables = boolean_variables_from_expression(&expression);
+	boolean_expression_drop(&expression);
+
+	expression = boolean_function_simplify_minterms(
+		simplifier,
+		NULL,
+		&minterms,
+		&variables,
+		budget,
+		parallel
+	);
+	boolean_budget_release_bytes(budget, minterms.length * sizeof(*minterms.data));
+	boolean_minterms_drop(&minterms);
+	boolean_variables_drop(&variables);
+
+	return expression;
+}
+void boolean_simplifier_drop(struct boolean_simplifier *simplifier) {
+	assert(simplifier != NULL);
+
+	for (size_t i = 0; i < sizeof(simplifier->workspaces) / sizeof(*simplifier->workspaces); i++) {
+		boolean_implicants_workspace_drop(&simplifier->workspaces[i]);
+	}
+	for (size_t i = 0; i < simplifier->components_count; i++) {
+		boolean_simplifier_drop(&simplifier->components[i]);
+	}
+	free(simplifier->components);
+}
+
+struct boolean_simplifier boolean_simplifier_new(void) {
+	return (struct boolean_simplifier){
+		.workspaces = {
+			boolean_implicants_workspace_new(),
+			boolean_implicants_workspace_new(),
+		},
+		.components = NULL,
+		.components_count = 0,
+	};
+}
+
+// degrades to a less simplified expression when a stage doesn't fit in the budget, and only fails
+// if the function itself is invalid, the minterms and implicants it finds along the way are cached
+// in the function, unless its expression splits into components that are simplified separately
+struct boolean_status boolean_simplifier_simplify(
+	struct boolean_simplifier *simplifier,
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	struct boolean_expression *expression
+) {
+	assert(simplifier != NULL && function != NULL && expression != NULL);
+
+	switch (function->representation) {
+		case boolean_function_representation_expression: {
+			*expression = boolean_function_simplify_expression(
+				simplifier,
+				function,
+				boolean_expression_clone(&function->expression),
+				budget,
+				true
+			);
+		} break;
+		case boolean_function_representation_minterms: {
+			size_t variables_count = function->variables.length;
+			if (variables_count >= 64) {
+				return boolean_status_failure(
+					"can't simplify a function of %zu variables",
+					variables_count
+				);
+			}
+			const struct boolean_minterms *minterms;
+			struct boolean_status status = boolean_function_minterms(function, budget, &minterms);
+			if (status.type != boolean_status_type_success) {
+				return status;
+			}
+
+			// minterms that don't even fit in the budget are left as they are
+			size_t minterms_bytes = minterms->length * sizeof(*minterms->data);
+			if (!boolean_budget_reserve_bytes(budget, minterms_bytes)) {
+				*expression = boolean_expression_from_minterms(minterms, &function->variables);
+				break;
+			}
+			*expression = boolean_function_simplify_minterms(
+				simplifier,
+				function,
+				minterms,
+				&function->variables,
+				budget,
+				true
+			);
+			boolean_budget_release_bytes(budget, minterms_bytes);
+		} break;
+	}
+
+	return boolean_status_success();
+}
+
+struct boolean_status boolean_function_simplify(
+	struct boolean_function *function,
+	struct boolean_budget *budget,
+	struct boolean_expression *expression
+) {
+	assert(function != NULL && expression != NULL);
+
+	struct boolean_simplifier simplifier = boolean_simplifier_new();
+	struct boolean_status status =
+		boolean_simplifier_simplify(&simplifier, function, budget, expression);
+	boolean_simplifier_drop(&simplifier);
+
+	return status;
+}
+
+struct boolean_status boolean_function_simplify_outputs(
+	const struct boolean_minterms *minterms,
+	size_t outputs_count,
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget,
+	struct boolean_expression *expressions
+) {
+	assert((minterms != NULL && expressions != NULL) || outputs_count == 0);
+	assert(variables != NULL);
+
+	// a single pass over all outputs, so products can be shared between them
+	struct boolean_shared_implicants implicants;
+	struct boolean_status status = boolean_shared_implicants_from_minterms(
+		minterms,
+		outputs_count,
+		variables,
+		budget,
+		NULL,
+		&implicants
+	);
+	if (status.type != boolean_status_type_success) {
+		return status;
+	}
+
+	// without a cover, every prime implicant is kept
+	status = boolean_shared_implicants_minimalize(&implicants, minterms, outputs_count, budget);
+	boolean_status_drop(&status);
+
+	for (size_t output = 0; output < outputs_count; output++) {
+		expressions[output] =
+			boolean_expression_from_shared_implicants(&implicants, output, variables);
+	}
+
+	boolean_shared_implicants_drop(&implicants);
+
+	return boolean_status_success();
+}
+
+struct boolean_function_batch {
+	const uint64_t *truth_tables;
+	uint64_t *canonical_truth_tables;
+	struct boolean_npn_transform *transforms;
+	size_t variables_count;
+	size_t words_count;
+};
+static void boolean_function_batch_canonicalize(size_t index, void *context) {
+	struct boolean_function_batch *batch = context;
+	boolean_npn_canonicalize(
+		&batch->truth_tables[index * batch->words_count],
+		batch->variables_count,
+		&batch->canonical_truth_tables[index * batch->words_count],
+		&batch->transforms[index]
+	);
+}
+struct boolean_function_class {
+	const uint64_t *canonical_truth_table;
+	size_t words_count;
+	size_t index;
+};
+static int boolean_function_class_compare(const void *class_1, const void *class_2) {
+	const struct boolean_function_class *function_class_1 = class_1;
+	const struct boolean_function_class *function_class_2 = class_2;
+
+	int comparison = memcmp(
+		function_class_1->canonical_truth_table,
+		function_class_2->canonical_truth_table,
+		function_class_1->words_count * sizeof(uint64_t)
+	);
+	if (comparison != 0) {
+		return comparison;
+	}
+	return (function_class_1->index > function_class_2->index) -
+		   (function_class_1->index < function_class_2->index);
+}
+// simplifies functions of the same variables, only simplifying one function of each class of
+// functions that are equal up to permuting or negating their inputs or negating their output, and
+// reading the simplifications of the others off of it, functions of too many variables to classify
+// are simplified one by one
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+struct boolean_status boolean_function_simplify_batch(
+	const struct boolean_minterms *minterms,
+	size_t functions_count,
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget,
+	struct boolean_expression *expressions
+) {
+	assert((minterms != NULL && expressions != NULL) || functions_count == 0);
+	assert(variables != NULL);
+
+	size_t variables_count = variables->length;
+	if (variables_count >= 64) {
+		return boolean_status_failure(
+			"can't simplify a function of %zu variables",
+			variables_count
+		);
+	}
+	for (size_t i = 0; i < functions_count; i++) {
+		struct boolean_status status =
+			boolean_function_check_minterms(&minterms[i], variables_count);
+		if (status.type != boolean_status_type_success) {
+			return status;
+		}
+	}
+
+	struct boolean_simplifier simplifier = boolean_simplifier_new();
+
+	// the tables of every function, and the minterms of the representative of a class, which are
+	// at most a row each
+	size_t words_count = 0;
+	size_t rows_count = 0;
+	size_t tables_bytes = SIZE_MAX;
+	if (variables_count <= BOOLEAN_NPN_VARIABLES_MAXIMUM) {
+		words_count = boolean_npn_words_count(variables_count);
+		rows_count = (size_t)1 << variables_count;
+		size_t function_bytes = 2 * words_count * sizeof(uint64_t) +
+								sizeof(struct boolean_npn_transform) +
+								sizeof(struct boolean_function_class);
+		size_t representative_bytes = rows_count * sizeof(uint64_t);
+		if (functions_count <= (SIZE_MAX - representative_bytes) / function_bytes) {
+			tables_bytes = functions_count * function_bytes + representative_bytes;
+		}
+	}
+	if (tables_bytes == SIZE_MAX || !boolean_budget_reserve_bytes(budget, tables_bytes)) {
+		for (size_t i = 0; i < functions_count; i++) {
+			expressions[i] = boolean_function_simplify_minterms(
+				&simplifier,
+				NULL,
+				&minterms[i],
+				variables,
+				budget,
+				true
+			);
+		}
+		boolean_simplifier_drop(&simplifier);
+		return boolean_status_success();
+	}
+
+	struct boolean_function_batch batch = {
+		.truth_tables = NULL,
+		.canonical_truth_tables = malloc(functions_count * words_count * sizeof(uint64_t)),
+		.transforms = malloc(functions_count * sizeof(*batch.transforms)),
+		.variables_count = variables_count,
+		.words_count = words_count,
+	};
+	uint64_t *truth_tables = calloc(functions_count * words_count, sizeof(*truth_tables));
+	struct boolean_function_class *classes = malloc(functions_count * sizeof(*classes));
+	assert(
+		(truth_tables != NULL && batch.canonical_truth_tables != NULL &&
+		 batch.transforms != NULL && classes != NULL) ||
+		functions_count == 0
+	);
+	batch.truth_tables = truth_tables;
+
+	for (size_t i = 0; i < functions_count; i++) {
+		for (size_t j = 0; j < minterms[i].length; j++) {
+			uint64_t minterm = minterms[i].data[j];
+			truth_tables[i * words_count + minterm / 64] |= UINT64_C(1) << (minterm % 64);
+		}
+	}
+	boolean_parallel_for(functions_count, boolean_function_batch_canonicalize, &batch);
+
+	for (size_t i = 0; i < functions_count; i++) {
+		classes[i] = (struct boolean_function_class){
+			.canonical_truth_table = &batch.canonical_truth_tables[i * words_count],
+			.words_count = words_count,
+			.index = i,
+		};
+	}
+	if (functions_count != 0) {
+		qsort(classes, functions_count, sizeof(*classes), boolean_function_class_compare);
+	}
+
+	struct boolean_minterms representative = {
+		.data = malloc(rows_count * sizeof(*representative.data)),
+		.length = 0,
+	};
+	assert(representative.data != NULL);
+	for (size_t start = 0, end = 0; start < functions_count; start = end) {
+		end = start + 1;
+		while (end < functions_count &&
+			   memcmp(
+				   classes[end].canonical_truth_table,
+				   classes[start].canonical_truth_table,
+				   words_count * sizeof(uint64_t)
+			   ) == 0) {
+			end++;
+		}
+
+		// the class is represented by its canonical function
+		representative.length = 0;
+		for (size_t row = 0; row < rows_count; row++) {
+			if (((classes[start].canonical_truth_table[row / 64] >> (row % 64)) & 1U) != 0) {
+				representative.data[representative.length++] = row;
+			}
+		}
+		struct boolean_expression expression = boolean_function_simplify_minterms(
+			&simplifier,
+			NULL,
+			&representative,
+			variables,
+			budget,
+			true
+		);
+
+		for (size_t i = start; i < end; i++) {
+			size_t index = classes[i].index;
+			expressions[index] =
+				boolean_expression_from_npn(&expression, variables, &batch.transforms[index]);
+		}
+		boolean_expression_drop(&expression);
+	}
+	boolean_minterms_drop(&representative);
+
+	free(classes);
+	free(truth_tables);
+	free(batch.transforms);
+	free(batch.canonical_truth_tables);
+	boolean_budget_release_bytes(budget, tables_bytes);
+	boolean_simplifier_drop(&simplifier);
+
+	return boolean_status_success();
 }
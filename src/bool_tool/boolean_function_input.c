@@ -63,17 +63,23 @@ static void boolean_function_input_init(BooleanFunctionInput *self) {
 	gtk_widget_init_template(GTK_WIDGET(self));
 }
 
-struct boolean_function boolean_function_input_get_function(const BooleanFunctionInput *self) {
-	struct boolean_function function;
+struct boolean_status boolean_function_input_get_function(
+	const BooleanFunctionInput *self,
+	struct boolean_function *function
+) {
 	switch (self->representation) {
 		case boolean_function_representation_expression: {
 			const char *expression_string =
 				gtk_editable_get_text(GTK_EDITABLE(self->expression_entry));
 
-			struct boolean_expression expression =
-				boolean_expression_from_string(expression_string);
+			struct boolean_expression expression;
+			struct boolean_status status =
+				boolean_expression_from_string(expression_string, &expression);
+			if (status.type != boolean_status_type_success) {
+				return status;
+			}
 
-			function = boolean_function_new_expression(expression);
+			*function = boolean_function_new_expression(expression);
 		} break;
 		case boolean_function_representation_minterms: {
 			const char *minterms_string = gtk_editable_get_text(GTK_EDITABLE(self->minterms_entry));
@@ -83,11 +89,11 @@ struct boolean_function boolean_function_input_get_function(const BooleanFunctio
 			struct boolean_minterms minterms = boolean_minterms_from_string(minterms_string);
 			struct boolean_variables variables = boolean_variables_from_string(variables_string);
 
-			function = boolean_function_new_minterms(minterms, variables);
+			*function = boolean_function_new_minterms(minterms, variables);
 		} break;
 	}
 
-	return function;
+	return boolean_status_success();
 }
 
 G_MODULE_EXPORT void dropdown_selected_changed(GtkDropDown *self, gpointer user_data) {
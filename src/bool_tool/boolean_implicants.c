@@ -5,6 +5,15 @@
 #include <stdlib.h>
 #include <string.h>
 
+// the scan for terms that can be combined is vectorized where the compiler can target extensions
+// on a per function basis, and the processor is checked for them at runtime
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(BOOL_TOOL_NO_SIMD)
+#define BOOLEAN_IMPLICANTS_AVX2_SUPPORTED 1
+#include <immintrin.h>
+#else
+#define BOOLEAN_IMPLICANTS_AVX2_SUPPORTED 0
+#endif
+
 static bool boolean_implicant_combinable(
 	struct boolean_implicant implicant_1,
 	struct boolean_implicant implicant_2
@@ -71,221 +80,1032 @@ void boolean_implicants_add(
 	implicants->data[implicants->length++] = implicant;
 }
 
+void boolean_implicants_workspace_drop(struct boolean_implicants_workspace *workspace) {
+	assert(workspace != NULL);
+
+	for (size_t i = 0; i < sizeof(workspace->tables) / sizeof(*workspace->tables); i++) {
+		free(workspace->tables[i].data);
+	}
+	free(workspace->cover);
+}
+
+struct boolean_implicants_workspace boolean_implicants_workspace_new(void) {
+	return (struct boolean_implicants_workspace){
+		.tables = {
+			{ .data = NULL, .capacity = 0 },
+			{ .data = NULL, .capacity = 0 },
+		},
+		.cover = NULL,
+		.cover_bytes = 0,
+	};
+}
+
+void boolean_shared_implicants_drop(struct boolean_shared_implicants *implicants) {
+	assert(implicants != NULL);
+
+	free(implicants->data);
+}
+
+struct boolean_shared_implicants boolean_shared_implicants_new(void) {
+	return (struct boolean_shared_implicants){
+		.data = NULL,
+		.length = 0,
+		.capacity = 0,
+	};
+}
+
+void boolean_shared_implicants_add(
+	struct boolean_shared_implicants *implicants,
+	struct boolean_shared_implicant implicant
+) {
+	assert(implicants != NULL);
+
+	if (implicants->length == implicants->capacity) {
+		if (implicants->capacity == 0) {
+			implicants->capacity = 1;
+		} else {
+			assert(implicants->capacity < SIZE_MAX / 2);
+			implicants->capacity *= 2;
+		}
+
+		struct boolean_shared_implicant *data =
+			realloc(implicants->data, implicants->capacity * sizeof(*implicants->data));
+		assert(data != NULL);
+
+		implicants->data = data;
+	}
+
+	implicants->data[implicants->length++] = implicant;
+}
+
+// the terms of a round of the Quine-McCluskey method, kept as parallel arrays so that scanning a
+// group streams through contiguous words, the terms of group i are those from offsets[i] up to
+// offsets[i + 1], and every array lives in a single allocation that's reused across rounds, and
+// across runs given a workspace
 struct table {
-	struct group {
-		struct term {
-			struct boolean_implicant implicant;
-			bool combined;
-		} *terms;
-		size_t terms_count;
-		size_t terms_capacity;
-	} *groups;
+	void *data;
+	uint64_t *values;
+	uint64_t *masks;
+	// the outputs each term is an implicant of
+	uint64_t *outputs;
+	// a bit per term, set once it's been combined for all of its outputs
+	uint64_t *combined;
+	// an open addressing hash of the terms, twice as many slots as the terms charged to the budget,
+	// each holding one more than the index of its term, or zero if it's empty
+	size_t *slots;
+	size_t terms_count;
+	// the terms charged to the budget, and the terms the allocation can hold, which may be more if
+	// it was kept from an earlier run
+	size_t terms_capacity;
+	size_t storage_capacity;
+
+	// functions of fewer than 64 variables have at most 64 groups
+	size_t offsets[64 + 1];
 	size_t groups_count;
+	struct boolean_budget *budget;
 };
-struct table table_new(size_t groups_count) {
+static size_t table_bytes(size_t terms_capacity) {
+	return terms_capacity * (3 * sizeof(uint64_t) + 2 * sizeof(size_t)) +
+		   (terms_capacity + 63) / 64 * sizeof(uint64_t);
+}
+// the arrays are laid out one after the other, each as long as the allocation can hold
+static void table_layout(struct table *table, void *data, size_t storage_capacity) {
+	table->data = data;
+	table->values = data;
+	table->masks = &table->values[storage_capacity];
+	table->outputs = &table->masks[storage_capacity];
+	table->slots = (size_t *)&table->outputs[storage_capacity];
+	table->combined = (uint64_t *)&table->slots[2 * storage_capacity];
+	table->storage_capacity = storage_capacity;
+}
+// the capacities are powers of two, so the slots are indexed by the top bits of the hash
+static size_t table_hash(uint64_t value, uint64_t mask, size_t slots_count) {
+	uint64_t hash = (value ^ mask * UINT64_C(0x9E3779B97F4A7C15)) * UINT64_C(0xBF58476D1CE4E5B9);
+	hash ^= hash >> 31;
+	return (size_t)hash & (slots_count - 1);
+}
+// finds the slot of the term with the given value and mask, or the empty slot it would go in
+static size_t *table_find(const struct table *table, uint64_t value, uint64_t mask) {
+	assert(table != NULL && table->terms_count < 2 * table->terms_capacity);
+
+	size_t slots_count = 2 * table->terms_capacity;
+	size_t slot = table_hash(value, mask, slots_count);
+	while (table->slots[slot] != 0) {
+		size_t index = table->slots[slot] - 1;
+		if (table->values[index] == value && table->masks[index] == mask) {
+			break;
+		}
+		slot = (slot + 1) & (slots_count - 1);
+	}
+
+	return &table->slots[slot];
+}
+// empties the slots in use and hashes every term again, after the capacity has changed
+static void table_rehash(struct table *table) {
+	assert(table != NULL);
+
+	memset(table->slots, 0, 2 * table->terms_capacity * sizeof(*table->slots));
+	for (size_t i = 0; i < table->terms_count; i++) {
+		*table_find(table, table->values[i], table->masks[i]) = i + 1;
+	}
+}
+// takes over the storage if it's given, which is left empty until the table is dropped
+static struct table table_new(
+	size_t groups_count,
+	struct boolean_budget *budget,
+	struct boolean_implicants_table_storage *storage
+) {
+	assert(groups_count <= 64);
+
 	struct table table = {
-		.groups = malloc(groups_count * sizeof(*table.groups)),
+		.data = NULL,
+		.values = NULL,
+		.masks = NULL,
+		.outputs = NULL,
+		.combined = NULL,
+		.slots = NULL,
+		.terms_count = 0,
+		.terms_capacity = 0,
+		.storage_capacity = 0,
+		.offsets = { 0 },
 		.groups_count = groups_count,
+		.budget = budget,
 	};
 
-	for (size_t j = 0; j < groups_count; j++) {
-		table.groups[j] = (struct group){
-			.terms = NULL,
-			.terms_count = 0,
-			.terms_capacity = 0,
-		};
+	if (storage != NULL && storage->data != NULL) {
+		table_layout(&table, storage->data, storage->capacity);
+		memset(table.combined, 0, (storage->capacity + 63) / 64 * sizeof(*table.combined));
+		storage->data = NULL;
+		storage->capacity = 0;
 	}
 
 	return table;
 }
-void table_drop(struct table *table) {
+// hands the table's allocation over to the storage if it's given, instead of freeing it
+static void table_drop(struct table *table, struct boolean_implicants_table_storage *storage) {
 	assert(table != NULL);
 
-	for (size_t i = 0; i < table->groups_count; i++) {
-		free(table->groups[i].terms);
+	boolean_budget_release_bytes(table->budget, table_bytes(table->terms_capacity));
+	if (storage != NULL) {
+		assert(storage->data == NULL);
+		storage->data = table->data;
+		storage->capacity = table->storage_capacity;
+	} else {
+		free(table->data);
 	}
-	free(table->groups);
 }
-void table_add_implicant(struct table *table, struct boolean_implicant implicant) {
+// returns false if growing the table would exceed its budget
+static bool table_reserve(struct table *table, size_t terms_count) {
 	assert(table != NULL);
 
-	int ones_count = __builtin_popcountll((implicant.value & implicant.mask));
-	assert(0 <= ones_count && (size_t)ones_count < table->groups_count);
+	if (terms_count <= table->terms_capacity) {
+		return true;
+	}
 
-	// if implicant is already in group, then don't add it
-	bool is_duplicate = false;
-	for (size_t i = 0; i < table->groups[ones_count].terms_count; i++) {
-		if (table->groups[ones_count].terms[i].implicant.mask == implicant.mask &&
-			table->groups[ones_count].terms[i].implicant.value == implicant.value) {
-			is_duplicate = true;
-			break;
+	size_t capacity = table->terms_capacity;
+	size_t new_capacity = capacity == 0 ? 64 : capacity;
+	while (new_capacity < terms_count) {
+		assert(new_capacity < SIZE_MAX / 2);
+		new_capacity *= 2;
+	}
+
+	size_t bytes = table_bytes(new_capacity) - table_bytes(capacity);
+	if (!boolean_budget_reserve_bytes(table->budget, bytes)) {
+		return false;
+	}
+	table->terms_capacity = new_capacity;
+
+	if (new_capacity <= table->storage_capacity) {
+		table_rehash(table);
+		return true;
+	}
+
+	// the arrays are moved apart, as each starts where the previous one's capacity ends
+	struct table grown = *table;
+	void *data = malloc(table_bytes(new_capacity));
+	assert(data != NULL);
+	table_layout(&grown, data, new_capacity);
+
+	size_t combined_words = (table->terms_count + 63) / 64;
+	if (table->terms_count != 0) {
+		memcpy(grown.values, table->values, table->terms_count * sizeof(*grown.values));
+		memcpy(grown.masks, table->masks, table->terms_count * sizeof(*grown.masks));
+		memcpy(grown.outputs, table->outputs, table->terms_count * sizeof(*grown.outputs));
+		memcpy(grown.combined, table->combined, combined_words * sizeof(*grown.combined));
+	}
+	memset(
+		&grown.combined[combined_words],
+		0,
+		((new_capacity + 63) / 64 - combined_words) * sizeof(*grown.combined)
+	);
+
+	free(table->data);
+	*table = grown;
+	table_rehash(table);
+
+	return true;
+}
+// empties the table, keeping its allocation for the next round
+static void table_clear(struct table *table) {
+	assert(table != NULL);
+
+	if (table->terms_count != 0) {
+		memset(table->combined, 0, (table->terms_count + 63) / 64 * sizeof(*table->combined));
+		memset(table->slots, 0, 2 * table->terms_capacity * sizeof(*table->slots));
+	}
+	table->terms_count = 0;
+	memset(table->offsets, 0, (table->groups_count + 1) * sizeof(*table->offsets));
+}
+// adds the implicant to the table, returns false if adding the implicant would exceed the table's
+// budget
+static bool table_add_implicant(
+	struct table *table,
+	struct boolean_implicant implicant,
+	uint64_t outputs
+) {
+	assert(table != NULL);
+
+	// if implicant is already in table, then don't add it, but it's an implicant of both outputs,
+	// the free bits of a combination are always cleared in its value, so equal terms compare equal
+	if (table->terms_count != 0) {
+		size_t *slot = table_find(table, implicant.value, implicant.mask);
+		if (*slot != 0) {
+			table->outputs[*slot - 1] |= outputs;
+			return true;
 		}
 	}
-	if (!is_duplicate) {
-		// if there isn't enough space for a new term, reallocate.
-		if (table->groups[ones_count].terms_count == table->groups[ones_count].terms_capacity) {
-			if (table->groups[ones_count].terms_capacity == 0) {
-				table->groups[ones_count].terms_capacity = 1;
-			} else {
-				assert(table->groups[ones_count].terms_capacity < SIZE_MAX / 2);
-				table->groups[ones_count].terms_capacity *= 2;
-			}
-			table->groups[ones_count].terms = realloc(
-				table->groups[ones_count].terms,
-				table->groups[ones_count].terms_capacity * sizeof(*table->groups[ones_count].terms)
-			);
-			assert(table->groups[ones_count].terms != NULL);
+
+	if (!boolean_budget_reserve_implicants(table->budget, 1) ||
+		!table_reserve(table, table->terms_count + 1)) {
+		return false;
+	}
+
+	*table_find(table, implicant.value, implicant.mask) = table->terms_count + 1;
+	table->values[table->terms_count] = implicant.value;
+	table->masks[table->terms_count] = implicant.mask;
+	table->outputs[table->terms_count] = outputs;
+	table->terms_count++;
+
+	return true;
+}
+// finds which of up to 64 terms the implicant can be combined with, as a bit per term
+static uint64_t table_scan_scalar(
+	struct boolean_implicant implicant,
+	uint64_t outputs,
+	const uint64_t *values,
+	const uint64_t *masks,
+	const uint64_t *terms_outputs,
+	size_t count
+) {
+	assert(count <= 64);
+
+	uint64_t matches = 0;
+	for (size_t i = 0; i < count; i++) {
+		struct boolean_implicant term = { .value = values[i], .mask = masks[i] };
+		bool match = (outputs & terms_outputs[i]) != 0 &&
+					 boolean_implicant_combinable(implicant, term);
+		matches |= (uint64_t)match << i;
+	}
+
+	return matches;
+}
+#if BOOLEAN_IMPLICANTS_AVX2_SUPPORTED
+// compares the implicant with four terms at a time, their values differ in a single bit if that
+// difference is nonzero and clearing its lowest bit leaves nothing
+__attribute__((__target__("avx2"))) static uint64_t table_scan_avx2(
+	struct boolean_implicant implicant,
+	uint64_t outputs,
+	const uint64_t *values,
+	const uint64_t *masks,
+	const uint64_t *terms_outputs,
+	size_t count
+) {
+	assert(count <= 64);
+
+	__m256i value = _mm256_set1_epi64x((long long)implicant.value);
+	__m256i mask = _mm256_set1_epi64x((long long)implicant.mask);
+	__m256i output = _mm256_set1_epi64x((long long)outputs);
+	__m256i zero = _mm256_setzero_si256();
+	__m256i ones = _mm256_set1_epi64x(-1);
+
+	uint64_t matches = 0;
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m256i terms_values = _mm256_loadu_si256((const __m256i *)&values[i]);
+		__m256i terms_masks = _mm256_loadu_si256((const __m256i *)&masks[i]);
+		__m256i terms_output = _mm256_loadu_si256((const __m256i *)&terms_outputs[i]);
+
+		__m256i difference = _mm256_and_si256(_mm256_xor_si256(value, terms_values), mask);
+		__m256i single = _mm256_cmpeq_epi64(
+			_mm256_and_si256(difference, _mm256_add_epi64(difference, ones)),
+			zero
+		);
+		__m256i equal = _mm256_cmpeq_epi64(terms_masks, mask);
+		__m256i empty = _mm256_cmpeq_epi64(difference, zero);
+		__m256i disjoint = _mm256_cmpeq_epi64(_mm256_and_si256(terms_output, output), zero);
+
+		__m256i match =
+			_mm256_andnot_si256(_mm256_or_si256(empty, disjoint), _mm256_and_si256(single, equal));
+		matches |= (uint64_t)(unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(match)) << i;
+	}
+	if (i < count) {
+		matches |= table_scan_scalar(
+					   implicant,
+					   outputs,
+					   &values[i],
+					   &masks[i],
+					   &terms_outputs[i],
+					   count - i
+				   )
+				   << i;
+	}
+
+	return matches;
+}
+#endif
+// picks the widest scan the processor supports
+static uint64_t (*table_scan_select(void))(
+	struct boolean_implicant implicant,
+	uint64_t outputs,
+	const uint64_t *values,
+	const uint64_t *masks,
+	const uint64_t *terms_outputs,
+	size_t count
+) {
+#if BOOLEAN_IMPLICANTS_AVX2_SUPPORTED
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return table_scan_avx2;
+	}
+#endif
+	return table_scan_scalar;
+}
+struct term {
+	uint64_t value;
+	uint64_t outputs;
+};
+// orders minterms by their number of ones, which is their group, and then by their value
+static int term_compare(const void *term_1, const void *term_2) {
+	uint64_t value_1 = ((const struct term *)term_1)->value;
+	uint64_t value_2 = ((const struct term *)term_2)->value;
+
+	int ones_count_1 = __builtin_popcountll(value_1);
+	int ones_count_2 = __builtin_popcountll(value_2);
+	if (ones_count_1 != ones_count_2) {
+		return ones_count_1 < ones_count_2 ? -1 : 1;
+	}
+	return (value_1 > value_2) - (value_1 < value_2);
+}
+// fills the table with the minterms of every output, grouped by their number of ones, returns
+// false if it would exceed the table's budget
+static bool table_from_minterms(
+	struct table *table,
+	const struct boolean_minterms *minterms,
+	size_t outputs_count,
+	uint64_t mask
+) {
+	size_t terms_count = 0;
+	for (size_t output = 0; output < outputs_count; output++) {
+		terms_count += minterms[output].length;
+	}
+
+	size_t bytes = terms_count * sizeof(struct term);
+	if (!boolean_budget_reserve_bytes(table->budget, bytes)) {
+		return false;
+	}
+	struct term *terms = malloc(bytes);
+	assert(terms != NULL || terms_count == 0);
+
+	size_t index = 0;
+	for (size_t output = 0; output < outputs_count; output++) {
+		for (size_t i = 0; i < minterms[output].length; i++) {
+			terms[index++] = (struct term){
+				.value = minterms[output].data[i],
+				.outputs = UINT64_C(1) << output,
+			};
+		}
+	}
+	if (terms_count != 0) {
+		qsort(terms, terms_count, sizeof(*terms), term_compare);
+	}
+
+	bool success = true;
+	size_t group = 0;
+	for (size_t i = 0; i < terms_count && success; i++) {
+		// a minterm of several outputs is a single term tagged with all of them
+		if (i != 0 && terms[i].value == terms[i - 1].value) {
+			table->outputs[table->terms_count - 1] |= terms[i].outputs;
+			continue;
+		}
+
+		size_t ones_count = (size_t)__builtin_popcountll(terms[i].value);
+		assert(ones_count < table->groups_count);
+		while (group < ones_count) {
+			table->offsets[++group] = table->terms_count;
+		}
+
+		success = boolean_budget_reserve_implicants(table->budget, 1) &&
+				  table_reserve(table, table->terms_count + 1);
+		if (success) {
+			table->values[table->terms_count] = terms[i].value;
+			table->masks[table->terms_count] = mask;
+			table->outputs[table->terms_count] = terms[i].outputs;
+			table->terms_count++;
 		}
-		table->groups[ones_count].terms[table->groups[ones_count].terms_count++] = (struct term){
-			.implicant = implicant,
-			.combined = false,
-		};
 	}
+	while (group < table->groups_count) {
+		table->offsets[++group] = table->terms_count;
+	}
+
+	free(terms);
+	boolean_budget_release_bytes(table->budget, bytes);
+
+	return success;
 }
-struct boolean_implicants boolean_implicants_from_minterms(
+// the Quine-McCluskey method over several functions at once, every term is tagged with the outputs
+// it's an implicant of, and terms are only combined for the outputs they have in common
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+struct boolean_status boolean_shared_implicants_from_minterms(
 	const struct boolean_minterms *minterms,
-	const struct boolean_variables *variables
+	size_t outputs_count,
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget,
+	struct boolean_implicants_workspace *workspace,
+	struct boolean_shared_implicants *implicants
 ) {
-	assert(minterms != NULL && variables != NULL);
+	assert((minterms != NULL || outputs_count == 0) && variables != NULL && implicants != NULL);
+	assert(outputs_count <= 64);
+
+	if (variables->length >= 64) {
+		return boolean_status_failure(
+			"can't find the implicants of a function of %zu variables",
+			variables->length
+		);
+	}
 
-	struct table input_table = table_new(variables->length + 1);
-	struct table output_table = table_new(variables->length + 1);
+	struct boolean_implicants_table_storage *storages =
+		workspace != NULL ? workspace->tables : NULL;
+	struct table input_table =
+		table_new(variables->length + 1, budget, storages != NULL ? &storages[0] : NULL);
+	struct table output_table =
+		table_new(variables->length + 1, budget, storages != NULL ? &storages[1] : NULL);
 
-	for (size_t i = 0; i < minterms->length; i++) {
-		table_add_implicant(
+	struct boolean_shared_implicants prime_implicants = boolean_shared_implicants_new();
+
+	struct boolean_status status = boolean_status_success();
+#define FAIL(...)                                                                                  \
+	do {                                                                                           \
+		status = boolean_status_failure(__VA_ARGS__);                                              \
+		goto cleanup;                                                                              \
+	} while (0)
+
+	if (!table_from_minterms(
 			&input_table,
-			(struct boolean_implicant){
-				.value = minterms->data[i],
-				.mask = (UINT64_C(1) << variables->length) - 1U,
-			}
-		);
+			minterms,
+			outputs_count,
+			(UINT64_C(1) << variables->length) - 1U
+		)) {
+		FAIL("finding the prime implicants exceeds the budget");
 	}
 
-	struct boolean_implicants prime_implicants = boolean_implicants_new();
+	uint64_t (*scan)(
+		struct boolean_implicant implicant,
+		uint64_t outputs,
+		const uint64_t *values,
+		const uint64_t *masks,
+		const uint64_t *terms_outputs,
+		size_t count
+	) = table_scan_select();
 
 	bool minimized = true;
 	do {
 		minimized = true;
 
+		if (boolean_budget_expired(budget)) {
+			FAIL("ran out of time while finding the prime implicants");
+		}
+
+		// combining a term with one of the next group frees a bit where it has a zero, so it keeps
+		// its number of ones, and the combinations of each group fill that group of the next round
+		// in order
+		table_clear(&output_table);
 		for (size_t i = 0; i < input_table.groups_count; i++) {
-			for (size_t j = 0; j < input_table.groups[i].terms_count; j++) {
-				if (i != input_table.groups_count - 1) {
-					for (size_t k = 0; k < input_table.groups[i + 1].terms_count; k++) {
-						// two implicants can be combined if their masks are equal
-						if (boolean_implicant_combinable(
-								input_table.groups[i].terms[j].implicant,
-								input_table.groups[i + 1].terms[k].implicant
-							)) {
+			output_table.offsets[i] = output_table.terms_count;
+
+			size_t group_end = input_table.offsets[i + 1];
+			size_t next_group_end =
+				i != input_table.groups_count - 1 ? input_table.offsets[i + 2] : group_end;
+			for (size_t j = input_table.offsets[i]; j < group_end; j++) {
+				struct boolean_implicant implicant_1 = {
+					.value = input_table.values[j],
+					.mask = input_table.masks[j],
+				};
+				uint64_t outputs_1 = input_table.outputs[j];
 
-							input_table.groups[i].terms[j].combined = true;
-							input_table.groups[i + 1].terms[k].combined = true;
+				for (size_t block = group_end; block < next_group_end; block += 64) {
+					size_t count = next_group_end - block < 64 ? next_group_end - block : 64;
+					uint64_t matches = scan(
+						implicant_1,
+						outputs_1,
+						&input_table.values[block],
+						&input_table.masks[block],
+						&input_table.outputs[block],
+						count
+					);
+
+					for (; matches != 0; matches &= matches - 1) {
+						size_t k = block + (size_t)__builtin_ctzll(matches);
+						struct boolean_implicant implicant_2 = {
+							.value = input_table.values[k],
+							.mask = input_table.masks[k],
+						};
+						uint64_t outputs_2 = input_table.outputs[k];
 
-							minimized = false;
+						// terms are only combined for the outputs they are both implicants of, and
+						// a term is only subsumed if the combination covers all its outputs
+						uint64_t outputs = outputs_1 & outputs_2;
+						input_table.combined[j / 64] |=
+							(uint64_t)(outputs == outputs_1) << (j % 64);
+						input_table.combined[k / 64] |=
+							(uint64_t)(outputs == outputs_2) << (k % 64);
 
-							table_add_implicant(
+						minimized = false;
+
+						if (!table_add_implicant(
 								&output_table,
-								boolean_implicant_combine(
-									input_table.groups[i].terms[j].implicant,
-									input_table.groups[i + 1].terms[k].implicant
-								)
-							);
+								boolean_implicant_combine(implicant_1, implicant_2),
+								outputs
+							)) {
+							FAIL("finding the prime implicants exceeds the budget");
 						}
 					}
 				}
 
-				if (!input_table.groups[i].terms[j].combined) {
-					boolean_implicants_add(
+				if ((input_table.combined[j / 64] >> (j % 64) & 1U) == 0) {
+					boolean_shared_implicants_add(
 						&prime_implicants,
-						input_table.groups[i].terms[j].implicant
+						(struct boolean_shared_implicant){
+							.implicant = implicant_1,
+							.outputs = outputs_1,
+						}
 					);
 				}
 			}
 		}
+		output_table.offsets[output_table.groups_count] = output_table.terms_count;
 
 		struct table table = input_table;
 		input_table = output_table;
 		output_table = table;
-		for (size_t i = 0; i < output_table.groups_count; i++) {
-			output_table.groups[i].terms_count = 0;
-		}
 	} while (!minimized);
 
-	table_drop(&input_table);
-	table_drop(&output_table);
+#undef FAIL
+
+cleanup:
+	table_drop(&input_table, storages != NULL ? &storages[0] : NULL);
+	table_drop(&output_table, storages != NULL ? &storages[1] : NULL);
+
+	if (status.type != boolean_status_type_success) {
+		boolean_shared_implicants_drop(&prime_implicants);
+		return status;
+	}
+
+	*implicants = prime_implicants;
+
+	return status;
+}
+struct boolean_status boolean_implicants_from_minterms(
+	const struct boolean_minterms *minterms,
+	const struct boolean_variables *variables,
+	struct boolean_budget *budget,
+	struct boolean_implicants_workspace *workspace,
+	struct boolean_implicants *implicants
+) {
+	assert(minterms != NULL && variables != NULL && implicants != NULL);
+
+	struct boolean_shared_implicants shared_implicants;
+	struct boolean_status status = boolean_shared_implicants_from_minterms(
+		minterms,
+		1,
+		variables,
+		budget,
+		workspace,
+		&shared_implicants
+	);
+	if (status.type != boolean_status_type_success) {
+		return status;
+	}
+
+	*implicants = (struct boolean_implicants){
+		.data = malloc(shared_implicants.length * sizeof(*implicants->data)),
+		.length = shared_implicants.length,
+		.capacity = shared_implicants.length,
+	};
+	assert(implicants->data != NULL || implicants->length == 0);
+
+	for (size_t i = 0; i < shared_implicants.length; i++) {
+		implicants->data[i] = shared_implicants.data[i].implicant;
+	}
+
+	boolean_shared_implicants_drop(&shared_implicants);
+
+	return status;
+}
+
+// writes the indices of the minterms the implicant covers, at most as many as there are minterms,
+// by looking up each of the implicant's own minterms, unless there are more of those than minterms
+static size_t boolean_implicant_covered(
+	struct boolean_implicant implicant,
+	const struct boolean_minterms *minterms,
+	size_t *indices
+) {
+	size_t covered_count = 0;
+
+	// no minterm has a bit set above the largest one's highest bit, so free variables above it
+	// can be ignored
+	uint64_t maximum = minterms->length != 0 ? minterms->data[minterms->length - 1] : 0;
+	uint64_t universe = maximum != 0 ? UINT64_MAX >> __builtin_clzll(maximum) : 0;
+	uint64_t free_mask = ~implicant.mask & universe;
+	int free_count = __builtin_popcountll(free_mask);
+	if (free_count < 64 && (UINT64_C(1) << free_count) <= minterms->length) {
+		// walks the subsets of the free bits
+		uint64_t subset = 0;
+		do {
+			size_t index =
+				boolean_minterms_find(minterms, (implicant.value & implicant.mask) | subset);
+			if (index != SIZE_MAX) {
+				indices[covered_count++] = index;
+			}
+			subset = (subset - free_mask) & free_mask;
+		} while (subset != 0);
+	} else {
+		for (size_t i = 0; i < minterms->length; i++) {
+			if (((implicant.value ^ minterms->data[i]) & implicant.mask) == 0) {
+				indices[covered_count++] = i;
+			}
+		}
+	}
 
-	return prime_implicants;
+	return covered_count;
 }
 
-void boolean_implicants_minimalize(
+// grows the scratch of the covering keeping its contents, in the workspace if it's given, where
+// it's kept once the covering is done
+static void *boolean_implicants_pool_grow(
+	struct boolean_implicants_workspace *workspace,
+	void *pool,
+	size_t bytes
+) {
+	if (workspace == NULL) {
+		pool = realloc(pool, bytes);
+		assert(pool != NULL);
+		return pool;
+	}
+
+	if (bytes > workspace->cover_bytes) {
+		workspace->cover = realloc(workspace->cover, bytes);
+		assert(workspace->cover != NULL);
+		workspace->cover_bytes = bytes;
+	}
+	return workspace->cover;
+}
+// leaves the implicants untouched if the covering can't be found within the budget
+struct boolean_status boolean_implicants_minimalize(
 	struct boolean_implicants *implicants,
-	const struct boolean_minterms *minterms
+	const struct boolean_minterms *minterms,
+	struct boolean_budget *budget,
+	struct boolean_implicants_workspace *workspace
 ) {
 	assert(implicants != NULL && minterms != NULL);
 
-	struct {
-		size_t *data;
-		size_t length;
-	} *factors = malloc(minterms->length * sizeof(*factors));
-	assert(factors != NULL);
+	size_t minterms_count = minterms->length;
+	size_t implicants_count = implicants->length;
 
-	size_t *frequencies = malloc(implicants->length * sizeof(*frequencies));
-	memset(frequencies, 0, implicants->length * sizeof(*frequencies));
+	// all the scratch lives in a single pool, which first holds what's needed to count the
+	// implicants covering each minterm, and then grows to hold those implicants and which of them
+	// are minimal
+	size_t counts_bytes = (3 * minterms_count + 1 + implicants_count) * sizeof(size_t);
+	if (!boolean_budget_reserve_bytes(budget, counts_bytes)) {
+		return boolean_status_failure(
+			"covering %zu minterms with %zu implicants exceeds the budget",
+			minterms_count,
+			implicants_count
+		);
+	}
 
-	for (size_t i = 0; i < minterms->length; i++) {
-		factors[i].data = malloc(implicants->length * sizeof(*factors[i].data));
-		assert(factors[i].data != NULL);
-		factors[i].length = 0;
+	size_t *pool = boolean_implicants_pool_grow(workspace, NULL, counts_bytes);
+	// where each minterm's implicants start, and where the next one is filled in
+	size_t *offsets = pool;
+	size_t *fill = &offsets[minterms_count + 1];
+	size_t *covered = &fill[minterms_count];
+	size_t *frequencies = &covered[minterms_count];
 
-		for (size_t j = 0; j < implicants->length; j++) {
-			if (((implicants->data[j].value ^ minterms->data[i]) & implicants->data[j].mask) == 0) {
-				factors[i].data[factors[i].length++] = j;
-				frequencies[j]++;
-			}
+	memset(offsets, 0, (minterms_count + 1) * sizeof(*offsets));
+	for (size_t j = 0; j < implicants_count; j++) {
+		size_t covered_count = boolean_implicant_covered(implicants->data[j], minterms, covered);
+		for (size_t k = 0; k < covered_count; k++) {
+			offsets[covered[k] + 1]++;
+		}
+		frequencies[j] = covered_count;
+	}
+	for (size_t i = 0; i < minterms_count; i++) {
+		offsets[i + 1] += offsets[i];
+	}
+
+	size_t edges_count = offsets[minterms_count];
+	size_t edges_bytes = edges_count * sizeof(size_t) + implicants_count * sizeof(bool);
+	if (!boolean_budget_reserve_bytes(budget, edges_bytes)) {
+		if (workspace == NULL) {
+			free(pool);
+		}
+		boolean_budget_release_bytes(budget, counts_bytes);
+		return boolean_status_failure(
+			"covering %zu minterms with %zu implicants exceeds the budget",
+			minterms_count,
+			implicants_count
+		);
+	}
+
+	pool = boolean_implicants_pool_grow(workspace, pool, counts_bytes + edges_bytes);
+	offsets = pool;
+	fill = &offsets[minterms_count + 1];
+	covered = &fill[minterms_count];
+	frequencies = &covered[minterms_count];
+	size_t *factors = &frequencies[implicants_count];
+	bool *minimal = (bool *)&factors[edges_count];
+
+	// filling the implicants in the order they're given keeps each minterm's implicants sorted
+	if (minterms_count != 0) {
+		memcpy(fill, offsets, minterms_count * sizeof(*fill));
+	}
+	for (size_t j = 0; j < implicants_count; j++) {
+		size_t covered_count = boolean_implicant_covered(implicants->data[j], minterms, covered);
+		for (size_t k = 0; k < covered_count; k++) {
+			factors[fill[covered[k]]++] = j;
 		}
 	}
 
-	bool *minimal = malloc(implicants->length * sizeof(*minimal));
-	memset(minimal, false, implicants->length * sizeof(*minimal));
-	for (size_t i = 0; i < minterms->length; i++) {
+	memset(minimal, false, implicants_count * sizeof(*minimal));
+	for (size_t i = 0; i < minterms_count; i++) {
+		assert(offsets[i] < offsets[i + 1]);
+
 		bool absorbed = false;
-		for (size_t j = 0; j < factors[i].length; j++) {
-			if (minimal[factors[i].data[j]]) {
+		for (size_t j = offsets[i]; j < offsets[i + 1]; j++) {
+			if (minimal[factors[j]]) {
 				absorbed = true;
 				break;
 			}
 		}
 		if (!absorbed) {
-			size_t most_frequent = factors[i].data[0];
-			for (size_t j = 1; j < factors[i].length; j++) {
-				if (frequencies[factors[i].data[j]] > frequencies[most_frequent]) {
-					most_frequent = factors[i].data[j];
+			size_t most_frequent = factors[offsets[i]];
+			for (size_t j = offsets[i] + 1; j < offsets[i + 1]; j++) {
+				if (frequencies[factors[j]] > frequencies[most_frequent]) {
+					most_frequent = factors[j];
 				}
 			}
 			minimal[most_frequent] = true;
 		}
 
-		for (size_t j = 0; j < factors[i].length; j++) {
-			frequencies[factors[i].data[j]]--;
+		for (size_t j = offsets[i]; j < offsets[i + 1]; j++) {
+			frequencies[factors[j]]--;
 		}
 	}
 
-	free(frequencies);
+	size_t minimal_count = 0;
+	for (size_t j = 0; j < implicants_count; j++) {
+		if (minimal[j]) {
+			implicants->data[minimal_count++] = implicants->data[j];
+		}
+	}
+	implicants->length = minimal_count;
 
-	for (size_t i = 0; i < minterms->length; i++) {
-		free(factors[i].data);
+	if (workspace == NULL) {
+		free(pool);
 	}
-	free(factors);
+	boolean_budget_release_bytes(budget, counts_bytes + edges_bytes);
+
+	return boolean_status_success();
+}
 
-	for (ptrdiff_t i = (ptrdiff_t)implicants->length - 1; i >= 0; i--) {
-		if (!minimal[i]) {
-			memmove(
-				&implicants->data[i],
-				&implicants->data[i + 1],
-				(implicants->length - (size_t)i - 1) * sizeof(*implicants->data)
+// picks a set of distinct products covering every minterm of every output, preferring products
+// shared between outputs, then narrows each chosen product's outputs to the ones that need it
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+struct boolean_status boolean_shared_implicants_minimalize(
+	struct boolean_shared_implicants *implicants,
+	const struct boolean_minterms *minterms,
+	size_t outputs_count,
+	struct boolean_budget *budget
+) {
+	assert(implicants != NULL && (minterms != NULL || outputs_count == 0));
+
+	// every (output, minterm) pair is an element to be covered
+	size_t elements_count = 0;
+	for (size_t output = 0; output < outputs_count; output++) {
+		elements_count += minterms[output].length;
+	}
+
+	// which implicants cover each element, and which elements each implicant covers
+	size_t *element_offsets = calloc(elements_count + 1, sizeof(*element_offsets));
+	size_t *implicant_offsets = calloc(implicants->length + 1, sizeof(*implicant_offsets));
+	assert(element_offsets != NULL && implicant_offsets != NULL);
+
+	size_t *output_offsets = malloc((outputs_count + 1) * sizeof(*output_offsets));
+	assert(output_offsets != NULL);
+	output_offsets[0] = 0;
+	size_t minterms_maximum = 0;
+	for (size_t output = 0; output < outputs_count; output++) {
+		output_offsets[output + 1] = output_offsets[output] + minterms[output].length;
+		if (minterms[output].length > minterms_maximum) {
+			minterms_maximum = minterms[output].length;
+		}
+	}
+
+	size_t *indices = malloc(minterms_maximum * sizeof(*indices));
+	assert(indices != NULL || minterms_maximum == 0);
+
+	for (size_t j = 0; j < implicants->length; j++) {
+		if (boolean_budget_expired(budget)) {
+			free(indices);
+			free(output_offsets);
+			free(implicant_offsets);
+			free(element_offsets);
+			return boolean_status_failure("ran out of time while covering the minterms");
+		}
+
+		for (size_t output = 0; output < outputs_count; output++) {
+			if (((implicants->data[j].outputs >> output) & 1U) == 0) {
+				continue;
+			}
+
+			size_t covered_count = boolean_implicant_covered(
+				implicants->data[j].implicant,
+				&minterms[output],
+				indices
+			);
+			for (size_t k = 0; k < covered_count; k++) {
+				element_offsets[output_offsets[output] + indices[k] + 1]++;
+			}
+			implicant_offsets[j + 1] += covered_count;
+		}
+	}
+	for (size_t element = 0; element < elements_count; element++) {
+		element_offsets[element + 1] += element_offsets[element];
+	}
+	for (size_t j = 0; j < implicants->length; j++) {
+		implicant_offsets[j + 1] += implicant_offsets[j];
+	}
+
+	size_t edges_count = element_offsets[elements_count];
+	size_t edges_bytes = 2 * edges_count * sizeof(size_t);
+	if (!boolean_budget_reserve_bytes(budget, edges_bytes)) {
+		free(indices);
+		free(output_offsets);
+		free(implicant_offsets);
+		free(element_offsets);
+		return boolean_status_failure(
+			"covering the minterms with %zu implicants exceeds the budget",
+			implicants->length
+		);
+	}
+
+	size_t *element_implicants = malloc(edges_count * sizeof(*element_implicants));
+	size_t *implicant_elements = malloc(edges_count * sizeof(*implicant_elements));
+	size_t *element_fill = malloc(elements_count * sizeof(*element_fill));
+	assert((element_implicants != NULL && implicant_elements != NULL) || edges_count == 0);
+	assert(element_fill != NULL || elements_count == 0);
+	if (elements_count != 0) {
+		memcpy(element_fill, element_offsets, elements_count * sizeof(*element_fill));
+	}
+
+	for (size_t j = 0; j < implicants->length; j++) {
+		size_t edge = implicant_offsets[j];
+		for (size_t output = 0; output < outputs_count; output++) {
+			if (((implicants->data[j].outputs >> output) & 1U) == 0) {
+				continue;
+			}
+
+			size_t covered_count = boolean_implicant_covered(
+				implicants->data[j].implicant,
+				&minterms[output],
+				indices
 			);
-			implicants->length--;
+			for (size_t k = 0; k < covered_count; k++) {
+				size_t element = output_offsets[output] + indices[k];
+				implicant_elements[edge++] = element;
+				element_implicants[element_fill[element]++] = j;
+			}
 		}
 	}
+	free(element_fill);
+	free(indices);
+
+	// the number of still uncovered elements each implicant covers
+	size_t *gains = malloc(implicants->length * sizeof(*gains));
+	bool *selected = calloc(implicants->length, sizeof(*selected));
+	// the number of selected implicants covering each element
+	size_t *coverings = calloc(elements_count, sizeof(*coverings));
+	assert((gains != NULL && selected != NULL) || implicants->length == 0);
+	assert(coverings != NULL || elements_count == 0);
+	for (size_t j = 0; j < implicants->length; j++) {
+		gains[j] = implicant_offsets[j + 1] - implicant_offsets[j];
+	}
+
+#define SELECT(index)                                                                              \
+	do {                                                                                           \
+		selected[(index)] = true;                                                                  \
+		for (size_t k = implicant_offsets[(index)]; k < implicant_offsets[(index) + 1]; k++) {     \
+			size_t covered = implicant_elements[k];                                                \
+			if (coverings[covered]++ == 0) {                                                       \
+				for (size_t l = element_offsets[covered]; l < element_offsets[covered + 1]; l++) { \
+					gains[element_implicants[l]]--;                                                \
+				}                                                                                  \
+			}                                                                                      \
+		}                                                                                          \
+	} while (0)
+
+	// essential implicants are the only ones covering some element
+	for (size_t element = 0; element < elements_count; element++) {
+		if (element_offsets[element + 1] - element_offsets[element] == 1) {
+			size_t essential = element_implicants[element_offsets[element]];
+			if (!selected[essential]) {
+				SELECT(essential);
+			}
+		}
+	}
+
+	// then greedily pick the implicant covering the most uncovered elements, preferring fewer
+	// literals on ties
+	while (1) {
+		size_t best = SIZE_MAX;
+		for (size_t j = 0; j < implicants->length; j++) {
+			if (selected[j] || gains[j] == 0) {
+				continue;
+			}
+			if (best == SIZE_MAX || gains[j] > gains[best] ||
+				(gains[j] == gains[best] &&
+				 __builtin_popcountll(implicants->data[j].implicant.mask) <
+					 __builtin_popcountll(implicants->data[best].implicant.mask))) {
+				best = j;
+			}
+		}
+		if (best == SIZE_MAX) {
+			break;
+		}
+		SELECT(best);
+	}
+
+#undef SELECT
+
+	// an output can be dropped from a selected implicant if every element it covers for that
+	// output is also covered by another selected implicant
+	for (size_t j = 0; j < implicants->length; j++) {
+		if (!selected[j]) {
+			continue;
+		}
+
+		for (size_t output = 0; output < outputs_count; output++) {
+			if (((implicants->data[j].outputs >> output) & 1U) == 0) {
+				continue;
+			}
+
+			bool redundant = true;
+			for (size_t k = implicant_offsets[j]; k < implicant_offsets[j + 1] && redundant; k++) {
+				size_t covered = implicant_elements[k];
+				if (output_offsets[output] <= covered && covered < output_offsets[output + 1]) {
+					redundant = coverings[covered] > 1;
+				}
+			}
+
+			if (redundant) {
+				implicants->data[j].outputs &= ~(UINT64_C(1) << output);
+				for (size_t k = implicant_offsets[j]; k < implicant_offsets[j + 1]; k++) {
+					size_t covered = implicant_elements[k];
+					if (output_offsets[output] <= covered && covered < output_offsets[output + 1]) {
+						coverings[covered]--;
+					}
+				}
+			}
+		}
+	}
+	free(output_offsets);
+
+	size_t length = 0;
+	for (size_t j = 0; j < implicants->length; j++) {
+		if (selected[j] && implicants->data[j].outputs != 0) {
+			implicants->data[length++] = implicants->data[j];
+		}
+	}
+	implicants->length = length;
+
+	free(coverings);
+	free(selected);
+	free(gains);
+	free(implicant_elements);
+	free(element_implicants);
+	free(implicant_offsets);
+	free(element_offsets);
+
+	boolean_budget_release_bytes(budget, edges_bytes);
 
-	free(minimal);
+	return boolean_status_success();
 }
@@ -0,0 +1,315 @@
+#include <bool_tool/boolean_jit.h>
+
+#include <assert.h>
+#include <bool_tool/boolean_variables.h>
+#include <stdlib.h>
+#include <string.h>
+
+// code is only generated for the System V calling convention, and needs pages that can be made
+// executable
+#if defined(__x86_64__) && !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+#define BOOLEAN_JIT_SUPPORTED 1
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define BOOLEAN_JIT_SUPPORTED 0
+#endif
+
+#if BOOLEAN_JIT_SUPPORTED
+// the columns, results, words count and loop index are kept in rdi, rsi, rdx and rcx, the values of
+// the nodes being evaluated in the rest of the caller saved registers, and on the stack once those
+// run out
+enum register_ {
+	register_rax = 0,
+	register_rcx = 1,
+	register_rdx = 2,
+	register_rsp = 4,
+	register_rsi = 6,
+	register_rdi = 7,
+	register_r8 = 8,
+	register_r9 = 9,
+	register_r10 = 10,
+	register_r11 = 11,
+};
+static const enum register_ value_registers[] = {
+	register_rax, register_r8, register_r9, register_r10, register_r11,
+};
+#define VALUE_REGISTERS_COUNT (sizeof(value_registers) / sizeof(*value_registers))
+
+#define REX_W 0x48U
+#define REX_R 0x04U
+#define REX_B 0x01U
+
+struct code {
+	uint8_t *data;
+	size_t length;
+	size_t capacity;
+};
+
+static void code_emit(struct code *code, size_t bytes_count, const uint8_t *bytes) {
+	if (code->length + bytes_count > code->capacity) {
+		code->capacity = (code->length + bytes_count) * 2;
+		code->data = realloc(code->data, code->capacity);
+		assert(code->data != NULL);
+	}
+	memcpy(&code->data[code->length], bytes, bytes_count);
+	code->length += bytes_count;
+}
+
+static void code_emit_u32(struct code *code, uint32_t value) {
+	uint8_t bytes[] = {
+		(uint8_t)value,
+		(uint8_t)(value >> 8),
+		(uint8_t)(value >> 16),
+		(uint8_t)(value >> 24),
+	};
+	code_emit(code, sizeof(bytes), bytes);
+}
+
+static uint8_t code_rex(unsigned int reg, unsigned int rm) {
+	return (uint8_t)(REX_W | (reg >= 8 ? REX_R : 0) | (rm >= 8 ? REX_B : 0));
+}
+
+static uint8_t code_modrm(unsigned int mod, unsigned int reg, unsigned int rm) {
+	return (uint8_t)((mod << 6) | ((reg & 7U) << 3) | (rm & 7U));
+}
+
+// loads the word at the loop index of the variable's column
+static void code_emit_load(struct code *code, enum register_ destination, size_t variable) {
+	// mov destination, [rdi + 8 * variable]
+	uint8_t load_column[] = {
+		code_rex(destination, register_rdi),
+		0x8B,
+		code_modrm(2, destination, register_rdi),
+	};
+	code_emit(code, sizeof(load_column), load_column);
+	code_emit_u32(code, (uint32_t)(variable * sizeof(uint64_t)));
+
+	// mov destination, [destination + 8 * rcx]
+	uint8_t load_word[] = {
+		code_rex(destination, destination),
+		0x8B,
+		code_modrm(0, destination, register_rsp),
+		(uint8_t)(0xC0U | (register_rcx << 3) | (destination & 7U)),
+	};
+	code_emit(code, sizeof(load_word), load_word);
+}
+
+static void code_emit_constant(struct code *code, enum register_ destination, bool value) {
+	if (value) {
+		// mov destination, -1
+		uint8_t move[] = {
+			code_rex(register_rax, destination),
+			0xC7,
+			code_modrm(3, register_rax, destination),
+		};
+		code_emit(code, sizeof(move), move);
+		code_emit_u32(code, UINT32_MAX);
+	} else {
+		// xor destination, destination
+		uint8_t clear[] = {
+			code_rex(destination, destination),
+			0x31,
+			code_modrm(3, destination, destination),
+		};
+		code_emit(code, sizeof(clear), clear);
+	}
+}
+
+// the opcodes combining a register with a register or with memory
+static uint8_t code_opcode(enum boolean_operation_type type) {
+	switch (type) {
+		case boolean_operation_type_conjunction: return 0x23;
+		case boolean_operation_type_disjunction: return 0x0B;
+		case boolean_operation_type_exclusive_disjunction: return 0x33;
+		case boolean_operation_type_negation: assert(false); break;
+	}
+	return 0;
+}
+
+// evaluates the expression into the register of the given depth
+static void code_emit_expression(
+	struct code *code,
+	const struct boolean_expression *expression,
+	size_t depth
+) {
+	enum register_ destination = value_registers[depth];
+
+	switch (expression->type) {
+		case boolean_expression_type_constant: {
+			code_emit_constant(code, destination, expression->constant.value);
+		} break;
+		case boolean_expression_type_variable: {
+			code_emit_load(
+				code,
+				destination,
+				boolean_environment_variable_index(expression->variable.name)
+			);
+		} break;
+		case boolean_expression_type_operation: {
+			const struct boolean_expression *operands = expression->operation.operands;
+			code_emit_expression(code, &operands[0], depth);
+
+			if (expression->operation.type == boolean_operation_type_negation) {
+				// not destination
+				uint8_t negate[] = {
+					code_rex(register_rax, destination),
+					0xF7,
+					code_modrm(3, 2, destination),
+				};
+				code_emit(code, sizeof(negate), negate);
+				break;
+			}
+
+			uint8_t opcode = code_opcode(expression->operation.type);
+			for (size_t i = 1; i < expression->operation.operands_count; i++) {
+				if (depth + 1 < VALUE_REGISTERS_COUNT) {
+					code_emit_expression(code, &operands[i], depth + 1);
+
+					// op destination, operand
+					enum register_ operand = value_registers[depth + 1];
+					uint8_t combine[] = {
+						code_rex(destination, operand),
+						opcode,
+						code_modrm(3, destination, operand),
+					};
+					code_emit(code, sizeof(combine), combine);
+				} else {
+					// the registers have run out, so the value so far is kept on the stack
+					if (destination >= 8) {
+						uint8_t prefix[] = { (uint8_t)(0x40U | REX_B) };
+						code_emit(code, sizeof(prefix), prefix);
+					}
+					uint8_t push[] = { (uint8_t)(0x50U | (destination & 7U)) };
+					code_emit(code, sizeof(push), push);
+
+					code_emit_expression(code, &operands[i], depth);
+
+					// op destination, [rsp]; add rsp, 8
+					uint8_t combine[] = {
+						code_rex(destination, register_rsp),
+						opcode,
+						code_modrm(0, destination, register_rsp),
+						0x24,
+						0x48,
+						0x83,
+						0xC4,
+						0x08,
+					};
+					code_emit(code, sizeof(combine), combine);
+				}
+			}
+		} break;
+	}
+}
+
+static void code_emit_function(struct code *code, const struct boolean_expression *expression) {
+	// test rdx, rdx; jz end; xor ecx, ecx
+	uint8_t prologue[] = { 0x48, 0x85, 0xD2, 0x0F, 0x84, 0, 0, 0, 0, 0x31, 0xC9 };
+	code_emit(code, sizeof(prologue), prologue);
+	size_t skip = code->length - 6;
+	size_t loop = code->length;
+
+	code_emit_expression(code, expression, 0);
+
+	// mov [rsi + 8 * rcx], rax; inc rcx; cmp rcx, rdx; jb loop
+	uint8_t store[] = { 0x48, 0x89, 0x04, 0xCE, 0x48, 0xFF, 0xC1, 0x48, 0x39, 0xD1, 0x0F, 0x82 };
+	code_emit(code, sizeof(store), store);
+	code_emit_u32(code, (uint32_t)(loop - (code->length + 4)));
+
+	uint32_t skip_offset = (uint32_t)(code->length - (skip + 4));
+	memcpy(&code->data[skip], &skip_offset, sizeof(skip_offset));
+
+	// ret
+	uint8_t epilogue[] = { 0xC3 };
+	code_emit(code, sizeof(epilogue), epilogue);
+}
+#endif
+
+void boolean_jit_drop(struct boolean_jit *jit) {
+	assert(jit != NULL);
+
+#if BOOLEAN_JIT_SUPPORTED
+	if (jit->code != NULL) {
+		(void)munmap(jit->code, jit->code_size);
+	}
+#endif
+	boolean_expression_drop(&jit->expression);
+}
+
+// compiles the expression if the platform allows it, otherwise keeps it to be interpreted
+struct boolean_jit boolean_jit_new(const struct boolean_expression *expression) {
+	assert(expression != NULL);
+
+	struct boolean_jit jit = {
+		.function = NULL,
+		.code = NULL,
+		.code_size = 0,
+		.expression = boolean_expression_clone(expression),
+		.support = boolean_environment_new(),
+	};
+	boolean_variables_from_expression_(expression, &jit.support);
+
+#if BOOLEAN_JIT_SUPPORTED
+	struct code code = { .data = NULL, .length = 0, .capacity = 0 };
+	code_emit_function(&code, expression);
+
+	long page_size = sysconf(_SC_PAGESIZE);
+	size_t size = page_size > 0 ? (size_t)page_size : 4096;
+	size = (code.length + size - 1) / size * size;
+
+	// the page is never writable and executable at once
+	void *page = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (page != MAP_FAILED) {
+		memcpy(page, code.data, code.length);
+		if (mprotect(page, size, PROT_READ | PROT_EXEC) == 0) {
+			jit.code = page;
+			jit.code_size = size;
+			memcpy(&jit.function, &page, sizeof(jit.function));
+		} else {
+			(void)munmap(page, size);
+		}
+	}
+	free(code.data);
+#endif
+
+	return jit;
+}
+
+bool boolean_jit_is_compiled(const struct boolean_jit *jit) {
+	assert(jit != NULL);
+
+	return jit->function != NULL;
+}
+
+// takes and returns environments the same way as boolean_expression_evaluate_batch
+void boolean_jit_evaluate(
+	const struct boolean_jit *jit,
+	const uint64_t *const *columns,
+	size_t environments_count,
+	uint64_t *results
+) {
+	assert(jit != NULL && columns != NULL && (results != NULL || environments_count == 0));
+
+	if (jit->function == NULL) {
+		boolean_expression_evaluate_batch(
+			&jit->expression,
+			columns,
+			environments_count,
+			results,
+			false
+		);
+		return;
+	}
+
+	for (size_t i = 0; i < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT; i++) {
+		assert(((jit->support.variables >> i) & 1U) == 0 || columns[i] != NULL);
+	}
+
+	size_t words_count = (environments_count + 63) / 64;
+	jit->function(columns, results, words_count);
+
+	if (environments_count % 64 != 0) {
+		results[words_count - 1] &= (UINT64_C(1) << (environments_count % 64)) - 1U;
+	}
+}
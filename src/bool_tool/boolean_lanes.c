@@ -0,0 +1,93 @@
+#include <bool_tool/boolean_lanes.h>
+
+#include <assert.h>
+
+// the rows of a word where the variable of the given bit of the row index is true
+static const uint64_t lane_patterns[BOOLEAN_LANE_VARIABLES_COUNT] = {
+	UINT64_C(0xAAAAAAAAAAAAAAAA), UINT64_C(0xCCCCCCCCCCCCCCCC), UINT64_C(0xF0F0F0F0F0F0F0F0),
+	UINT64_C(0xFF00FF00FF00FF00), UINT64_C(0xFFFF0000FFFF0000), UINT64_C(0xFFFFFFFF00000000),
+};
+
+// takes the indices of the variables by the bits of the row index, and starts at the first word
+static struct boolean_lanes boolean_lanes_new(const size_t *indices, size_t variables_count) {
+	assert(indices != NULL && variables_count <= BOOLEAN_ENVIRONMENT_VARIABLES_COUNT);
+
+	struct boolean_lanes lanes = {
+		.indices = { 0 },
+		.variables_count = variables_count,
+		.lane_variables_count = variables_count < BOOLEAN_LANE_VARIABLES_COUNT
+									? variables_count
+									: BOOLEAN_LANE_VARIABLES_COUNT,
+		.lanes_mask = UINT64_MAX,
+		.words = { 0 },
+	};
+	if (lanes.lane_variables_count < BOOLEAN_LANE_VARIABLES_COUNT) {
+		lanes.lanes_mask = (UINT64_C(1) << (UINT64_C(1) << lanes.lane_variables_count)) - 1U;
+	}
+
+	for (size_t bit = 0; bit < variables_count; bit++) {
+		lanes.indices[bit] = indices[bit];
+		if (bit < lanes.lane_variables_count) {
+			lanes.words[indices[bit]] = lane_patterns[bit];
+		}
+	}
+
+	return lanes;
+}
+
+// the variables of the support in the order of their indices, the first being bit 0 of the row
+struct boolean_lanes boolean_lanes_from_support(const struct boolean_environment *support) {
+	assert(support != NULL);
+
+	size_t indices[BOOLEAN_ENVIRONMENT_VARIABLES_COUNT];
+	size_t variables_count = 0;
+	for (size_t i = 0; i < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT; i++) {
+		if (((support->variables >> i) & 1U) != 0) {
+			indices[variables_count++] = i;
+		}
+	}
+
+	return boolean_lanes_new(indices, variables_count);
+}
+
+// the variables in the order of minterms, the variable at position i being bit n - 1 - i of the row
+struct boolean_lanes boolean_lanes_from_variables(const struct boolean_variables *variables) {
+	assert(variables != NULL && variables->length <= BOOLEAN_ENVIRONMENT_VARIABLES_COUNT);
+
+	size_t indices[BOOLEAN_ENVIRONMENT_VARIABLES_COUNT];
+	for (size_t i = 0; i < variables->length; i++) {
+		indices[variables->length - 1 - i] =
+			boolean_environment_variable_index(variables->data[i]);
+	}
+
+	return boolean_lanes_new(indices, variables->length);
+}
+
+uint64_t boolean_lanes_words_count(const struct boolean_lanes *lanes) {
+	assert(lanes != NULL);
+
+	return UINT64_C(1) << (lanes->variables_count - lanes->lane_variables_count);
+}
+
+// sets the variables that vary between words to their values over the rows of the given word
+void boolean_lanes_set_word(struct boolean_lanes *lanes, uint64_t word) {
+	assert(lanes != NULL && word < boolean_lanes_words_count(lanes));
+
+	for (size_t bit = lanes->lane_variables_count; bit < lanes->variables_count; bit++) {
+		bool value = ((word >> (bit - lanes->lane_variables_count)) & 1U) != 0;
+		lanes->words[lanes->indices[bit]] = value ? UINT64_MAX : 0;
+	}
+}
+
+// the value of the expression over the rows of the given word, with the lanes that aren't rows
+// cleared
+uint64_t boolean_lanes_evaluate(
+	struct boolean_lanes *lanes,
+	const struct boolean_expression *expression,
+	uint64_t word
+) {
+	assert(lanes != NULL && expression != NULL);
+
+	boolean_lanes_set_word(lanes, word);
+	return boolean_expression_evaluate_word(expression, lanes->words) & lanes->lanes_mask;
+}
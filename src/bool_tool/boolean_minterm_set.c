@@ -0,0 +1,355 @@
+#include <bool_tool/boolean_minterm_set.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BITSET_WORDS_COUNT (BOOLEAN_MINTERM_CONTAINER_SPAN / 64)
+
+static void boolean_minterm_container_drop(struct boolean_minterm_container *container) {
+	assert(container != NULL);
+
+	switch (container->representation) {
+		case boolean_minterm_container_representation_array: {
+			free(container->array.data);
+		} break;
+		case boolean_minterm_container_representation_bitset: {
+			free(container->bitset);
+		} break;
+	}
+}
+static struct boolean_minterm_container boolean_minterm_container_new(uint64_t key) {
+	return (struct boolean_minterm_container){
+		.key = key,
+		.length = 0,
+		.representation = boolean_minterm_container_representation_array,
+		.array = { .data = NULL, .capacity = 0 },
+	};
+}
+
+// writes the container's members into a bitset of BITSET_WORDS_COUNT words
+static void boolean_minterm_container_to_bitset(
+	const struct boolean_minterm_container *container,
+	uint64_t *bitset
+) {
+	switch (container->representation) {
+		case boolean_minterm_container_representation_array: {
+			memset(bitset, 0, BITSET_WORDS_COUNT * sizeof(*bitset));
+			for (size_t i = 0; i < container->length; i++) {
+				uint16_t value = container->array.data[i];
+				bitset[value / 64] |= UINT64_C(1) << (value % 64);
+			}
+		} break;
+		case boolean_minterm_container_representation_bitset: {
+			memcpy(bitset, container->bitset, BITSET_WORDS_COUNT * sizeof(*bitset));
+		} break;
+	}
+}
+// takes ownership of the bitset, and switches to an array if it's sparse enough
+static struct boolean_minterm_container boolean_minterm_container_from_bitset(
+	uint64_t key,
+	uint64_t *bitset
+) {
+	assert(bitset != NULL);
+
+	size_t length = 0;
+	for (size_t i = 0; i < BITSET_WORDS_COUNT; i++) {
+		length += (size_t)__builtin_popcountll(bitset[i]);
+	}
+
+	if (length > BOOLEAN_MINTERM_CONTAINER_ARRAY_MAXIMUM) {
+		return (struct boolean_minterm_container){
+			.key = key,
+			.length = length,
+			.representation = boolean_minterm_container_representation_bitset,
+			.bitset = bitset,
+		};
+	}
+
+	struct boolean_minterm_container container = boolean_minterm_container_new(key);
+	container.array.data = malloc(length * sizeof(*container.array.data));
+	assert(container.array.data != NULL || length == 0);
+	container.array.capacity = length;
+	for (size_t i = 0; i < BITSET_WORDS_COUNT; i++) {
+		for (uint64_t word = bitset[i]; word != 0; word &= word - 1) {
+			container.array.data[container.length++] =
+				(uint16_t)(i * 64 + (size_t)__builtin_ctzll(word));
+		}
+	}
+	free(bitset);
+
+	return container;
+}
+
+// the index of the first value in the array that isn't less than the given value
+static size_t boolean_minterm_container_lower_bound(
+	const struct boolean_minterm_container *container,
+	uint16_t value
+) {
+	size_t low = 0;
+	size_t high = container->length;
+	while (low < high) {
+		size_t middle = low + (high - low) / 2;
+		if (container->array.data[middle] < value) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+static bool boolean_minterm_container_add(
+	struct boolean_minterm_container *container,
+	uint16_t value
+) {
+	switch (container->representation) {
+		case boolean_minterm_container_representation_array: {
+			// minterms are mostly added in increasing order, so appending is checked first
+			size_t index = container->length;
+			if (container->length != 0 && container->array.data[container->length - 1] >= value) {
+				index = boolean_minterm_container_lower_bound(container, value);
+				if (container->array.data[index] == value) {
+					return false;
+				}
+			}
+
+			if (container->length == BOOLEAN_MINTERM_CONTAINER_ARRAY_MAXIMUM) {
+				uint64_t *bitset = malloc(BITSET_WORDS_COUNT * sizeof(*bitset));
+				assert(bitset != NULL);
+				boolean_minterm_container_to_bitset(container, bitset);
+				free(container->array.data);
+
+				container->representation = boolean_minterm_container_representation_bitset;
+				container->bitset = bitset;
+
+				return boolean_minterm_container_add(container, value);
+			}
+
+			if (container->length == container->array.capacity) {
+				container->array.capacity =
+					container->array.capacity == 0 ? 4 : container->array.capacity * 2;
+				container->array.data = realloc(
+					container->array.data,
+					container->array.capacity * sizeof(*container->array.data)
+				);
+				assert(container->array.data != NULL);
+			}
+
+			memmove(
+				&container->array.data[index + 1],
+				&container->array.data[index],
+				(container->length - index) * sizeof(*container->array.data)
+			);
+			container->array.data[index] = value;
+			container->length++;
+		} break;
+		case boolean_minterm_container_representation_bitset: {
+			uint64_t bit = UINT64_C(1) << (value % 64);
+			if ((container->bitset[value / 64] & bit) != 0) {
+				return false;
+			}
+			container->bitset[value / 64] |= bit;
+			container->length++;
+		} break;
+	}
+
+	return true;
+}
+
+void boolean_minterm_set_drop(struct boolean_minterm_set *set) {
+	assert(set != NULL);
+
+	for (size_t i = 0; i < set->containers_count; i++) {
+		boolean_minterm_container_drop(&set->containers[i]);
+	}
+	free(set->containers);
+}
+
+struct boolean_minterm_set boolean_minterm_set_new(void) {
+	return (struct boolean_minterm_set){
+		.containers = NULL,
+		.containers_count = 0,
+		.containers_capacity = 0,
+	};
+}
+
+// makes room for at least one more container
+static void boolean_minterm_set_reserve(struct boolean_minterm_set *set) {
+	if (set->containers_count == set->containers_capacity) {
+		set->containers_capacity = set->containers_capacity == 0 ? 1 : set->containers_capacity * 2;
+		set->containers =
+			realloc(set->containers, set->containers_capacity * sizeof(*set->containers));
+		assert(set->containers != NULL);
+	}
+}
+// appends a container with a key greater than all others, dropping it instead if it's empty
+static void boolean_minterm_set_push(
+	struct boolean_minterm_set *set,
+	struct boolean_minterm_container container
+) {
+	if (container.length == 0) {
+		boolean_minterm_container_drop(&container);
+		return;
+	}
+
+	boolean_minterm_set_reserve(set);
+	set->containers[set->containers_count++] = container;
+}
+
+struct boolean_minterm_set boolean_minterm_set_from_minterms(const struct boolean_minterms *minterms
+) {
+	assert(minterms != NULL);
+
+	struct boolean_minterm_set set = boolean_minterm_set_new();
+	for (size_t i = 0; i < minterms->length; i++) {
+		(void)boolean_minterm_set_add(&set, minterms->data[i]);
+	}
+
+	return set;
+}
+
+size_t boolean_minterm_set_length(const struct boolean_minterm_set *set) {
+	assert(set != NULL);
+
+	size_t length = 0;
+	for (size_t i = 0; i < set->containers_count; i++) {
+		length += set->containers[i].length;
+	}
+
+	return length;
+}
+
+// the index of the first container whose key isn't less than the given key
+static size_t boolean_minterm_set_lower_bound(const struct boolean_minterm_set *set, uint64_t key) {
+	size_t low = 0;
+	size_t high = set->containers_count;
+	while (low < high) {
+		size_t middle = low + (high - low) / 2;
+		if (set->containers[middle].key < key) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+bool boolean_minterm_set_add(struct boolean_minterm_set *set, uint64_t minterm) {
+	assert(set != NULL);
+
+	uint64_t key = minterm / BOOLEAN_MINTERM_CONTAINER_SPAN;
+	uint16_t value = (uint16_t)(minterm % BOOLEAN_MINTERM_CONTAINER_SPAN);
+
+	size_t index = set->containers_count;
+	if (set->containers_count != 0 && set->containers[set->containers_count - 1].key >= key) {
+		index = boolean_minterm_set_lower_bound(set, key);
+	}
+
+	if (index == set->containers_count || set->containers[index].key != key) {
+		boolean_minterm_set_reserve(set);
+		memmove(
+			&set->containers[index + 1],
+			&set->containers[index],
+			(set->containers_count - index) * sizeof(*set->containers)
+		);
+		set->containers[index] = boolean_minterm_container_new(key);
+		set->containers_count++;
+	}
+
+	return boolean_minterm_container_add(&set->containers[index], value);
+}
+
+// the minterms over the given number of variables that aren't in the set
+struct boolean_minterm_set boolean_minterm_set_complement(
+	const struct boolean_minterm_set *set,
+	size_t variables_count
+) {
+	assert(set != NULL && variables_count < 64);
+
+	uint64_t rows_count = UINT64_C(1) << variables_count;
+	uint64_t keys_count =
+		(rows_count + BOOLEAN_MINTERM_CONTAINER_SPAN - 1) / BOOLEAN_MINTERM_CONTAINER_SPAN;
+
+	struct boolean_minterm_set complement = boolean_minterm_set_new();
+
+	size_t index = 0;
+	for (uint64_t key = 0; key < keys_count; key++) {
+		uint64_t *bitset = malloc(BITSET_WORDS_COUNT * sizeof(*bitset));
+		assert(bitset != NULL);
+
+		// only the first container can be partial, when there are fewer than 16 variables
+		uint64_t span = rows_count;
+		if (span > BOOLEAN_MINTERM_CONTAINER_SPAN) {
+			span = BOOLEAN_MINTERM_CONTAINER_SPAN;
+		}
+		for (size_t i = 0; i < BITSET_WORDS_COUNT; i++) {
+			uint64_t start = (uint64_t)i * 64;
+			if (start + 64 <= span) {
+				bitset[i] = UINT64_MAX;
+			} else if (start < span) {
+				bitset[i] = (UINT64_C(1) << (span - start)) - 1U;
+			} else {
+				bitset[i] = 0;
+			}
+		}
+
+		while (index < set->containers_count && set->containers[index].key < key) {
+			index++;
+		}
+		if (index < set->containers_count && set->containers[index].key == key) {
+			const struct boolean_minterm_container *container = &set->containers[index];
+			switch (container->representation) {
+				case boolean_minterm_container_representation_array: {
+					for (size_t i = 0; i < container->length; i++) {
+						uint16_t value = container->array.data[i];
+						bitset[value / 64] &= ~(UINT64_C(1) << (value % 64));
+					}
+				} break;
+				case boolean_minterm_container_representation_bitset: {
+					for (size_t i = 0; i < BITSET_WORDS_COUNT; i++) {
+						bitset[i] &= ~container->bitset[i];
+					}
+				} break;
+			}
+		}
+
+		boolean_minterm_set_push(&complement, boolean_minterm_container_from_bitset(key, bitset));
+	}
+
+	return complement;
+}
+
+struct boolean_minterms boolean_minterms_from_set(const struct boolean_minterm_set *set) {
+	assert(set != NULL);
+
+	size_t length = boolean_minterm_set_length(set);
+	struct boolean_minterms minterms = {
+		.data = malloc(length * sizeof(*minterms.data)),
+		.length = 0,
+	};
+	assert(minterms.data != NULL || length == 0);
+
+	// containers are in increasing order of their keys, so the minterms come out sorted
+	for (size_t i = 0; i < set->containers_count; i++) {
+		const struct boolean_minterm_container *container = &set->containers[i];
+		uint64_t base = container->key * BOOLEAN_MINTERM_CONTAINER_SPAN;
+
+		switch (container->representation) {
+			case boolean_minterm_container_representation_array: {
+				for (size_t j = 0; j < container->length; j++) {
+					minterms.data[minterms.length++] = base + container->array.data[j];
+				}
+			} break;
+			case boolean_minterm_container_representation_bitset: {
+				for (size_t j = 0; j < BITSET_WORDS_COUNT; j++) {
+					for (uint64_t word = container->bitset[j]; word != 0; word &= word - 1) {
+						minterms.data[minterms.length++] =
+							base + j * 64 + (uint64_t)__builtin_ctzll(word);
+					}
+				}
+			} break;
+		}
+	}
+
+	return minterms;
+}
@@ -1,9 +1,15 @@
 #include <bool_tool/boolean_minterms.h>
 
 #include <assert.h>
+#include <bool_tool/boolean_enumeration.h>
+#include <bool_tool/boolean_lanes.h>
+#include <bool_tool/boolean_minterm_set.h>
+#include <bool_tool/boolean_parallel.h>
 #include <bool_tool/boolean_variables.h>
 #include <errno.h>
 #include <inttypes.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -29,23 +35,12 @@ void boolean_minterms_drop(struct boolean_minterms *minterms) {
 }
 
 struct boolean_minterms boolean_minterms_from_string(const char *string) {
-	size_t length = 1;
-	for (size_t i = 0; string[i] != '\0'; i++) {
-		if (string[i] == ',') {
-			length++;
-		}
-	}
-
-	struct boolean_minterms minterms = {
-		.data = malloc(length * sizeof(*minterms.data)),
-		.length = 0,
-	};
-	assert(minterms.data != NULL);
+	// going through a set sorts the minterms and drops repeated ones
+	struct boolean_minterm_set set = boolean_minterm_set_new();
 
+	char *end = NULL;
 	for (const char *i = string; *i != '\0'; i++) {
-		char *end = NULL;
-		assert(minterms.length < length);
-		minterms.data[minterms.length++] = (uint64_t)strtoumax(i, &end, 10);
+		(void)boolean_minterm_set_add(&set, (uint64_t)strtoumax(i, &end, 10));
 
 		if (end == i) {
 			(void)fprintf(stderr, "Error: failed to parse minterm from \"%s\"\n", i);
@@ -61,6 +56,9 @@ struct boolean_minterms boolean_minterms_from_string(const char *string) {
 		}
 	}
 
+	struct boolean_minterms minterms = boolean_minterms_from_set(&set);
+	boolean_minterm_set_drop(&set);
+
 	return minterms;
 }
 
@@ -123,33 +121,222 @@ char *boolean_minterms_to_string(const struct boolean_minterms *minterms) {
 	return string;
 }
 
-struct boolean_minterms boolean_minterms_from_expression(const struct boolean_expression *expression
+// the minterms over the given number of variables that aren't in the set
+struct boolean_minterms boolean_minterms_complement(
+	const struct boolean_minterms *minterms,
+	size_t variables_count
+) {
+	assert(minterms != NULL && variables_count < 64);
+
+	struct boolean_minterm_set set = boolean_minterm_set_from_minterms(minterms);
+	struct boolean_minterm_set complement = boolean_minterm_set_complement(&set, variables_count);
+	boolean_minterm_set_drop(&set);
+
+	struct boolean_minterms minterms_complement = boolean_minterms_from_set(&complement);
+	boolean_minterm_set_drop(&complement);
+
+	return minterms_complement;
+}
+
+// the index of the minterm in the minterms, or SIZE_MAX if it isn't one of them
+size_t boolean_minterms_find(const struct boolean_minterms *minterms, uint64_t minterm) {
+	assert(minterms != NULL);
+
+	size_t low = 0;
+	size_t high = minterms->length;
+	while (low < high) {
+		size_t middle = low + (high - low) / 2;
+		if (minterms->data[middle] < minterm) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	return low < minterms->length && minterms->data[low] == minterm ? low : SIZE_MAX;
+}
+
+// how many words of the truth table each thread evaluates at a time, a container's span, which is
+// also how often the deadline is checked
+#define CHUNK_WORDS (BOOLEAN_MINTERM_CONTAINER_SPAN / 64)
+
+struct expansion {
+	const struct boolean_enumeration *enumeration;
+	const struct boolean_variables *variables;
+	struct boolean_budget *budget;
+	uint64_t *bitset;
+	size_t words_count;
+	atomic_bool expired;
+};
+static void boolean_minterms_expand_chunk(size_t index, void *context) {
+	struct expansion *expansion = context;
+	if (atomic_load(&expansion->expired)) {
+		return;
+	}
+	if (boolean_budget_expired(expansion->budget)) {
+		atomic_store(&expansion->expired, true);
+		return;
+	}
+
+	// the variable at position j of the variables is bit n - 1 - j of the row
+	struct boolean_lanes lanes = boolean_lanes_from_variables(expansion->variables);
+
+	// the words of a chunk are visited in gray code order, so that a single variable changes
+	// between one word and the next, and only the operations above it are evaluated again, the
+	// words of a chunk being a power of two
+	const struct boolean_enumeration *enumeration = expansion->enumeration;
+	uint64_t *values = malloc(enumeration->nodes_count * sizeof(*values));
+	assert(values != NULL);
+
+	size_t start = index * CHUNK_WORDS;
+	size_t count = expansion->words_count - start < CHUNK_WORDS ? expansion->words_count - start
+																: CHUNK_WORDS;
+	boolean_lanes_set_word(&lanes, start);
+	boolean_enumeration_evaluate(enumeration, lanes.words, values);
+	expansion->bitset[start] = values[0] & lanes.lanes_mask;
+	for (size_t step = 1; step < count; step++) {
+		// the bit of the word that changes between consecutive gray codes is the lowest set bit of
+		// the step
+		size_t bit = lanes.lane_variables_count + (size_t)__builtin_ctzll(step);
+		boolean_enumeration_flip(enumeration, lanes.indices[bit], values);
+		expansion->bitset[start + (step ^ (step >> 1))] = values[0] & lanes.lanes_mask;
+	}
+
+	free(values);
+}
+
+// the truth table over the variables of the expression, rows being packed like minterms, the value
+// on row r being bit r % 64 of word r / 64, and the bits past the last row being clear, its bytes
+// stay reserved from the budget once it's returned, for the caller to release when it frees it
+struct boolean_status boolean_truth_table_from_expression(
+	const struct boolean_expression *expression,
+	struct boolean_budget *budget,
+	uint64_t **truth_table
 ) {
-	assert(expression != NULL);
+	assert(expression != NULL && truth_table != NULL);
 
 	struct boolean_variables variables = boolean_variables_from_expression(expression);
 
+	size_t variables_count = variables.length;
+	if (variables_count >= 64 || (UINT64_C(1) << variables_count) > SIZE_MAX / 8) {
+		boolean_variables_drop(&variables);
+		return boolean_status_failure(
+			"can't expand an expression of %zu variables into a truth table",
+			variables_count
+		);
+	}
+
+	size_t rows_count = (size_t)1 << variables_count;
+	size_t words_count = (rows_count + 63) / 64;
+	size_t bytes = words_count * sizeof(uint64_t);
+	if (!boolean_budget_reserve_bytes(budget, bytes)) {
+		boolean_variables_drop(&variables);
+		return boolean_status_failure(
+			"expanding %zu variables into a truth table needs %zu bytes, which exceeds the budget",
+			variables_count,
+			bytes
+		);
+	}
+
+	// the chunks are whole words of the truth table, so threads never write to the same word
+	struct boolean_enumeration enumeration = boolean_enumeration_new(expression);
+	struct expansion expansion = {
+		.enumeration = &enumeration,
+		.variables = &variables,
+		.budget = budget,
+		.bitset = malloc(bytes),
+		.words_count = words_count,
+	};
+	assert(expansion.bitset != NULL);
+	atomic_init(&expansion.expired, false);
+
+	boolean_parallel_for(
+		(words_count + CHUNK_WORDS - 1) / CHUNK_WORDS,
+		boolean_minterms_expand_chunk,
+		&expansion
+	);
+	boolean_enumeration_drop(&enumeration);
+	boolean_variables_drop(&variables);
+
+	if (atomic_load(&expansion.expired)) {
+		free(expansion.bitset);
+		boolean_budget_release_bytes(budget, bytes);
+		return boolean_status_failure("ran out of time while expanding the expression");
+	}
+
+	*truth_table = expansion.bitset;
+	return boolean_status_success();
+}
+
+static size_t boolean_truth_table_count(const uint64_t *truth_table, size_t words_count) {
+	size_t count = 0;
+	for (size_t word = 0; word < words_count; word++) {
+		count += (size_t)__builtin_popcountll(truth_table[word]);
+	}
+	return count;
+}
+// the rows of a truth table over the given number of variables where it's true
+struct boolean_minterms boolean_minterms_from_truth_table(
+	const uint64_t *truth_table,
+	size_t variables_count
+) {
+	assert(truth_table != NULL && variables_count < 64);
+
+	size_t words_count = (((size_t)1 << variables_count) + 63) / 64;
+	size_t length = boolean_truth_table_count(truth_table, words_count);
+
 	struct boolean_minterms minterms = {
-		.data = malloc((1U << variables.length) * sizeof(*minterms.data)),
+		.data = malloc(length * sizeof(*minterms.data)),
 		.length = 0,
 	};
+	assert(minterms.data != NULL || length == 0);
 
-	for (uint64_t i = 0; i < (1U << variables.length); i++) {
-		struct boolean_environment environment = boolean_environment_new();
-		for (size_t j = 0; j < variables.length; j++) {
-			boolean_environment_set_variable(
-				&environment,
-				variables.data[variables.length - j - 1],
-				(i >> j) & 1U
-			);
+	for (size_t word = 0; word < words_count; word++) {
+		for (uint64_t bits = truth_table[word]; bits != 0; bits &= bits - 1U) {
+			minterms.data[minterms.length++] = word * 64 + (uint64_t)__builtin_ctzll(bits);
 		}
+	}
 
-		if (boolean_expression_evaluate(expression, &environment)) {
-			minterms.data[minterms.length++] = i;
-		}
+	return minterms;
+}
+
+// the bytes of the minterms stay reserved from the budget once they're returned, for the caller to
+// release when it drops them
+struct boolean_status boolean_minterms_from_expression(
+	const struct boolean_expression *expression,
+	struct boolean_budget *budget,
+	struct boolean_minterms *minterms
+) {
+	assert(expression != NULL && minterms != NULL);
+
+	uint64_t *truth_table;
+	struct boolean_status status =
+		boolean_truth_table_from_expression(expression, budget, &truth_table);
+	if (status.type != boolean_status_type_success) {
+		return status;
 	}
 
+	struct boolean_variables variables = boolean_variables_from_expression(expression);
+	size_t variables_count = variables.length;
 	boolean_variables_drop(&variables);
 
-	return minterms;
+	size_t words_count = (((size_t)1 << variables_count) + 63) / 64;
+	size_t length = boolean_truth_table_count(truth_table, words_count);
+
+	// the minterms are listed beside the truth table, which is freed once they are
+	size_t minterms_bytes = length * sizeof(*minterms->data);
+	if (!boolean_budget_reserve_bytes(budget, minterms_bytes)) {
+		free(truth_table);
+		boolean_budget_release_bytes(budget, words_count * sizeof(*truth_table));
+		return boolean_status_failure(
+			"listing the minterms needs %zu bytes, which exceeds the budget",
+			minterms_bytes
+		);
+	}
+
+	*minterms = boolean_minterms_from_truth_table(truth_table, variables_count);
+	free(truth_table);
+	boolean_budget_release_bytes(budget, words_count * sizeof(*truth_table));
+
+	return boolean_status_success();
 }
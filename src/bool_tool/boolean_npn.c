@@ -0,0 +1,335 @@
+#include <bool_tool/boolean_npn.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+// past this many candidate transforms, the search keeps the smallest truth table it's found, which
+// is still equivalent to the function, but may differ between functions of the same class, when
+// both polarities of the output are searched each gets half of them
+#define NPN_CANDIDATES_MAXIMUM 4096
+
+size_t boolean_npn_words_count(size_t variables_count) {
+	assert(variables_count <= BOOLEAN_NPN_VARIABLES_MAXIMUM);
+
+	return variables_count <= 6 ? 1 : (size_t)1 << (variables_count - 6);
+}
+
+void boolean_npn_apply(
+	const uint64_t *truth_table,
+	size_t variables_count,
+	const struct boolean_npn_transform *transform,
+	uint64_t *result
+) {
+	assert(truth_table != NULL && transform != NULL && result != NULL);
+	assert(variables_count <= BOOLEAN_NPN_VARIABLES_MAXIMUM);
+
+	// the row read is the xor of the bits each of the row's bits maps to, and of the negated ones,
+	// which is looked up for the low and high byte of the row separately
+	uint32_t negations = 0;
+	uint32_t low[256];
+	uint32_t high[256];
+	low[0] = 0;
+	high[0] = 0;
+	for (size_t i = 0; i < variables_count; i++) {
+		if (((transform->input_negations >> i) & 1U) != 0) {
+			negations |= UINT32_C(1) << transform->permutation[i];
+		}
+	}
+	for (size_t row = 1; row < 256; row++) {
+		size_t bit = (size_t)__builtin_ctzll(row);
+		uint32_t low_bit = bit < variables_count ? UINT32_C(1) << transform->permutation[bit] : 0;
+		uint32_t high_bit =
+			bit + 8 < variables_count ? UINT32_C(1) << transform->permutation[bit + 8] : 0;
+		low[row] = low[row & (row - 1)] ^ low_bit;
+		high[row] = high[row & (row - 1)] ^ high_bit;
+	}
+
+	uint64_t output_negation = transform->output_negation ? 1U : 0U;
+	size_t rows_count = (size_t)1 << variables_count;
+	memset(result, 0, boolean_npn_words_count(variables_count) * sizeof(*result));
+	for (size_t row = 0; row < rows_count; row++) {
+		uint32_t read = negations ^ low[row & 255U] ^ high[row >> 8];
+		uint64_t value = ((truth_table[read / 64] >> (read % 64)) & 1U) ^ output_negation;
+		result[row / 64] |= value << (row % 64);
+	}
+}
+
+struct npn_search {
+	const uint64_t *truth_table;
+	size_t variables_count;
+	size_t words_count;
+
+	// the bits of the original rows ordered by their signatures, each bit of the canonical rows
+	// taking one of the bits of its group
+	uint8_t order[BOOLEAN_NPN_VARIABLES_MAXIMUM];
+	size_t group_starts[BOOLEAN_NPN_VARIABLES_MAXIMUM];
+	size_t group_ends[BOOLEAN_NPN_VARIABLES_MAXIMUM];
+	// the bits of the original rows that are negated, and those that could go either way
+	uint32_t negations;
+	uint32_t free_negations;
+
+	struct boolean_npn_transform transform;
+	uint32_t used;
+
+	uint64_t *candidate;
+	uint64_t *best;
+	struct boolean_npn_transform best_transform;
+	size_t candidates_count;
+	size_t candidates_maximum;
+};
+
+// compares truth tables as numbers, the last row being the most significant bit
+static int boolean_npn_compare(const uint64_t *table_1, const uint64_t *table_2, size_t words) {
+	for (size_t i = words; i-- > 0;) {
+		if (table_1[i] != table_2[i]) {
+			return table_1[i] < table_2[i] ? -1 : 1;
+		}
+	}
+	return 0;
+}
+
+static void boolean_npn_search(struct npn_search *search, size_t bit) {
+	if (search->candidates_count >= search->candidates_maximum) {
+		return;
+	}
+
+	if (bit == search->variables_count) {
+		boolean_npn_apply(
+			search->truth_table,
+			search->variables_count,
+			&search->transform,
+			search->candidate
+		);
+		if (search->candidates_count == 0 ||
+			boolean_npn_compare(search->candidate, search->best, search->words_count) < 0) {
+			memcpy(search->best, search->candidate, search->words_count * sizeof(*search->best));
+			search->best_transform = search->transform;
+		}
+		search->candidates_count++;
+		return;
+	}
+
+	for (size_t i = search->group_starts[bit]; i < search->group_ends[bit]; i++) {
+		uint32_t original = UINT32_C(1) << search->order[i];
+		if ((search->used & original) != 0) {
+			continue;
+		}
+
+		search->used |= original;
+		search->transform.permutation[bit] = search->order[i];
+		for (uint32_t negated = 0; negated < 2; negated++) {
+			if ((search->free_negations & original) == 0 &&
+				negated != ((search->negations & original) != 0 ? 1U : 0U)) {
+				continue;
+			}
+
+			search->transform.input_negations &= ~(UINT32_C(1) << bit);
+			search->transform.input_negations |= negated << bit;
+			boolean_npn_search(search, bit + 1);
+		}
+		search->used &= ~original;
+	}
+}
+
+// the canonical form is the smallest truth table any transform gives, the transforms tried being
+// narrowed down by signatures no transform changes, the output is negated to have fewer ones, each
+// input to have fewer ones where it's true, and the inputs are ordered by those counts and by how
+// unevenly the function is split by each pair of inputs, only ties being searched exhaustively
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+void boolean_npn_canonicalize(
+	const uint64_t *truth_table,
+	size_t variables_count,
+	uint64_t *canonical,
+	struct boolean_npn_transform *transform
+) {
+	assert(truth_table != NULL && canonical != NULL && transform != NULL);
+	assert(variables_count <= BOOLEAN_NPN_VARIABLES_MAXIMUM);
+
+	size_t words_count = boolean_npn_words_count(variables_count);
+	size_t rows_count = (size_t)1 << variables_count;
+
+	// the ones where each bit of the row is set, and where each pair of bits is
+	uint64_t ones_count = 0;
+	uint64_t bit_ones[BOOLEAN_NPN_VARIABLES_MAXIMUM] = { 0 };
+	uint64_t pair_ones[BOOLEAN_NPN_VARIABLES_MAXIMUM][BOOLEAN_NPN_VARIABLES_MAXIMUM] = { { 0 } };
+	for (size_t row = 0; row < rows_count; row++) {
+		if (((truth_table[row / 64] >> (row % 64)) & 1U) == 0) {
+			continue;
+		}
+		ones_count++;
+		for (size_t i = 0; i < variables_count; i++) {
+			if (((row >> i) & 1U) == 0) {
+				continue;
+			}
+			bit_ones[i]++;
+			for (size_t j = i + 1; j < variables_count; j++) {
+				pair_ones[i][j] += (row >> j) & 1U;
+			}
+		}
+	}
+
+	// how unevenly each pair of inputs splits the ones, squared so negating either leaves it as is
+	uint64_t imbalances[BOOLEAN_NPN_VARIABLES_MAXIMUM] = { 0 };
+	for (size_t i = 0; i < variables_count; i++) {
+		for (size_t j = i + 1; j < variables_count; j++) {
+			int64_t both = (int64_t)pair_ones[i][j];
+			int64_t only_i = (int64_t)bit_ones[i] - both;
+			int64_t only_j = (int64_t)bit_ones[j] - both;
+			int64_t neither = (int64_t)ones_count - both - only_i - only_j;
+			int64_t imbalance = both + neither - only_i - only_j;
+			imbalances[i] += (uint64_t)(imbalance * imbalance);
+			imbalances[j] += (uint64_t)(imbalance * imbalance);
+		}
+	}
+
+	struct npn_search search = {
+		.truth_table = truth_table,
+		.variables_count = variables_count,
+		.words_count = words_count,
+		.candidate = malloc(words_count * sizeof(*search.candidate)),
+		.best = canonical,
+		.candidates_count = 0,
+		.candidates_maximum = 0,
+	};
+	assert(search.candidate != NULL);
+
+	// both polarities are searched only when the function is as often true as it's false
+	size_t polarities_count = 2 * ones_count == rows_count ? 2 : 1;
+	for (uint32_t output_negation = 0; output_negation < 2; output_negation++) {
+		uint64_t output_ones = output_negation != 0 ? rows_count - ones_count : ones_count;
+		if (output_ones > rows_count - output_ones) {
+			continue;
+		}
+		search.candidates_maximum =
+			search.candidates_count + NPN_CANDIDATES_MAXIMUM / polarities_count;
+
+		uint64_t signatures[BOOLEAN_NPN_VARIABLES_MAXIMUM];
+		search.negations = 0;
+		search.free_negations = 0;
+		for (size_t i = 0; i < variables_count; i++) {
+			uint64_t set = output_negation != 0 ? rows_count / 2 - bit_ones[i] : bit_ones[i];
+			uint64_t clear = output_ones - set;
+			if (set > clear) {
+				search.negations |= UINT32_C(1) << i;
+			} else if (set == clear) {
+				search.free_negations |= UINT32_C(1) << i;
+			}
+			signatures[i] = set < clear ? set : clear;
+		}
+
+		// insertion sort keeps bits with equal signatures in order
+		for (size_t i = 0; i < variables_count; i++) {
+			size_t j = i;
+			for (; j > 0 && (signatures[search.order[j - 1]] > signatures[i] ||
+							 (signatures[search.order[j - 1]] == signatures[i] &&
+							  imbalances[search.order[j - 1]] > imbalances[i]));
+				 j--) {
+				search.order[j] = search.order[j - 1];
+			}
+			search.order[j] = (uint8_t)i;
+		}
+		for (size_t start = 0, end = 0; start < variables_count; start = end) {
+			size_t first = search.order[start];
+			end = start + 1;
+			while (end < variables_count && signatures[search.order[end]] == signatures[first] &&
+				   imbalances[search.order[end]] == imbalances[first]) {
+				end++;
+			}
+			for (size_t i = start; i < end; i++) {
+				search.group_starts[i] = start;
+				search.group_ends[i] = end;
+			}
+		}
+
+		search.transform = (struct boolean_npn_transform){
+			.permutation = { 0 },
+			.input_negations = 0,
+			.output_negation = output_negation != 0,
+		};
+		search.used = 0;
+		boolean_npn_search(&search, 0);
+	}
+
+	free(search.candidate);
+
+	*transform = search.best_transform;
+}
+
+static struct boolean_expression boolean_npn_substitute(
+	const struct boolean_expression *expression,
+	const struct boolean_variables *variables,
+	const struct boolean_npn_transform *transform,
+	bool negated
+) {
+	switch (expression->type) {
+		case boolean_expression_type_constant: {
+			return boolean_expression_new_constant(expression->constant.value != negated);
+		} break;
+		case boolean_expression_type_variable: {
+			const char *position =
+				memchr(variables->data, expression->variable.name, variables->length);
+			assert(position != NULL);
+
+			// variable j of the variables is bit n - 1 - j of the row
+			size_t bit = variables->length - 1 - (size_t)(position - variables->data);
+			char name = variables->data[variables->length - 1 - transform->permutation[bit]];
+			bool literal_negated = (((transform->input_negations >> bit) & 1U) != 0) != negated;
+
+			struct boolean_expression literal = boolean_expression_new_variable(name);
+			if (!literal_negated) {
+				return literal;
+			}
+			return boolean_expression_new_operation(boolean_operation_type_negation, literal);
+		} break;
+		case boolean_expression_type_operation: {
+			const struct boolean_expression *operands = expression->operation.operands;
+			size_t operands_count = expression->operation.operands_count;
+
+			enum boolean_operation_type type = expression->operation.type;
+			if (type == boolean_operation_type_negation) {
+				return boolean_npn_substitute(&operands[0], variables, transform, !negated);
+			}
+
+			// negations are pushed down to the literals, which keeps the number of literals
+			if (negated && type == boolean_operation_type_conjunction) {
+				type = boolean_operation_type_disjunction;
+			} else if (negated && type == boolean_operation_type_disjunction) {
+				type = boolean_operation_type_conjunction;
+			}
+
+			struct boolean_expression *substituted =
+				malloc(operands_count * sizeof(*substituted));
+			assert(substituted != NULL);
+			for (size_t i = 0; i < operands_count; i++) {
+				// negating an exclusive disjunction negates only one of its operands
+				bool operand_negated = negated;
+				if (type == boolean_operation_type_exclusive_disjunction) {
+					operand_negated = negated && i == 0;
+				}
+				substituted[i] =
+					boolean_npn_substitute(&operands[i], variables, transform, operand_negated);
+			}
+
+			return boolean_expression_new_operation_from_operands(
+				type,
+				substituted,
+				operands_count
+			);
+		} break;
+	}
+
+	return boolean_expression_new_constant(false);
+}
+
+// turns an expression of a function read through the transform back into one of the function it
+// was read from, whose inputs are the same variables
+struct boolean_expression boolean_expression_from_npn(
+	const struct boolean_expression *expression,
+	const struct boolean_variables *variables,
+	const struct boolean_npn_transform *transform
+) {
+	assert(expression != NULL && variables != NULL && transform != NULL);
+
+	return boolean_npn_substitute(expression, variables, transform, transform->output_negation);
+}
@@ -0,0 +1,141 @@
+#include <bool_tool/boolean_ordering.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+// a variable stops moving in a direction once the diagram grows past this many times the size it
+// had at the best level found for it
+#define SIFT_GROWTH_MAXIMUM 2
+
+static void boolean_ordering_visit(
+	const struct boolean_expression *expression,
+	struct boolean_variables *order,
+	struct boolean_environment *seen
+) {
+	switch (expression->type) {
+		case boolean_expression_type_constant: break;
+		case boolean_expression_type_variable: {
+			if (!boolean_environment_get_variable(seen, expression->variable.name)) {
+				boolean_environment_set_variable(seen, expression->variable.name, true);
+				order->data[order->length++] = expression->variable.name;
+			}
+		} break;
+		case boolean_expression_type_operation: {
+			size_t operands_count = expression->operation.operands_count;
+			size_t *indices = malloc(operands_count * sizeof(*indices));
+			size_t *weights = malloc(operands_count * sizeof(*weights));
+			assert(indices != NULL && weights != NULL);
+
+			// operands over more variables are visited first, insertion sort keeps ties in order
+			for (size_t i = 0; i < operands_count; i++) {
+				struct boolean_environment support = boolean_environment_new();
+				boolean_variables_from_expression_(&expression->operation.operands[i], &support);
+				weights[i] = (size_t)__builtin_popcountll(support.variables);
+
+				size_t j = i;
+				for (; j > 0 && weights[indices[j - 1]] < weights[i]; j--) {
+					indices[j] = indices[j - 1];
+				}
+				indices[j] = i;
+			}
+
+			for (size_t i = 0; i < operands_count; i++) {
+				boolean_ordering_visit(&expression->operation.operands[indices[i]], order, seen);
+			}
+
+			free(weights);
+			free(indices);
+		} break;
+	}
+}
+
+// orders the variables as a depth first traversal first meets them, going into the operands that
+// depend on the most variables first, which keeps variables that interact close together
+struct boolean_variables boolean_variables_order_from_expression(
+	const struct boolean_expression *expression
+) {
+	assert(expression != NULL);
+
+	struct boolean_variables order = {
+		.data = malloc(BOOLEAN_ENVIRONMENT_VARIABLES_COUNT * sizeof(*order.data)),
+		.length = 0,
+	};
+	assert(order.data != NULL);
+
+	struct boolean_environment seen = boolean_environment_new();
+	boolean_ordering_visit(expression, &order, &seen);
+
+	return order;
+}
+
+// reorders the diagram by sifting, swapping each variable in turn down to the last level and up to
+// the first, then back to the level where the diagram was smallest, the other nodes of the diagram
+// are lost, if it runs out of budget it stops with the diagram in the best order found so far
+struct boolean_status boolean_bdd_sift(
+	struct boolean_bdd *bdd,
+	uint32_t *node,
+	struct boolean_budget *budget
+) {
+	assert(bdd != NULL && node != NULL && *node < bdd->nodes_count);
+
+	if (!boolean_bdd_reorder_begin(bdd, node)) {
+		return boolean_status_failure("reordering the decision diagram exceeds the budget");
+	}
+
+	uint32_t levels_count = (uint32_t)bdd->variables.length;
+	struct boolean_variables names = boolean_variables_clone(&bdd->variables);
+	bool expired = false;
+	bool exhausted = false;
+	for (size_t i = 0; i < names.length && !expired && !exhausted; i++) {
+		uint32_t level = bdd->levels[boolean_environment_variable_index(names.data[i])];
+		uint32_t best_level = level;
+		size_t best_size = bdd->live_nodes_count;
+
+		// the variable goes towards the closer end first
+		bool down = level >= levels_count / 2;
+		for (size_t direction = 0; direction < 2 && !expired && !exhausted; direction++) {
+			while (down ? level + 1 < levels_count : level > 0) {
+				expired = boolean_budget_expired(budget);
+				if (expired) {
+					break;
+				}
+				exhausted = !boolean_bdd_swap(bdd, down ? level : level - 1);
+				if (exhausted) {
+					break;
+				}
+				level = down ? level + 1 : level - 1;
+
+				if (bdd->live_nodes_count < best_size) {
+					best_size = bdd->live_nodes_count;
+					best_level = level;
+				}
+				if (bdd->live_nodes_count > SIFT_GROWTH_MAXIMUM * best_size) {
+					break;
+				}
+			}
+			down = !down;
+		}
+
+		// going back only shrinks the diagram, so it fits in the budget unless growing it to make
+		// room for the swaps doesn't
+		while (level != best_level &&
+			   boolean_bdd_swap(bdd, level < best_level ? level : level - 1)) {
+			level = level < best_level ? level + 1 : level - 1;
+		}
+		exhausted = exhausted || level != best_level;
+
+		// the nodes that died are dropped, so that the next variable has room to move
+		boolean_bdd_compact(bdd, node);
+	}
+	boolean_variables_drop(&names);
+
+	boolean_bdd_reorder_end(bdd, node);
+
+	if (expired) {
+		return boolean_status_failure("ran out of time while sifting the decision diagram");
+	}
+	if (exhausted) {
+		return boolean_status_failure("sifting the decision diagram exceeds the budget");
+	}
+	return boolean_status_success();
+}
@@ -0,0 +1,96 @@
+#include <bool_tool/boolean_parallel.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#ifndef __STDC_NO_THREADS__
+#include <stdatomic.h>
+#include <threads.h>
+#endif
+
+size_t boolean_parallel_threads_count(void) {
+#if defined(_WIN32)
+	SYSTEM_INFO information;
+	GetSystemInfo(&information);
+	return information.dwNumberOfProcessors > 0 ? (size_t)information.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (size_t)count : 1;
+#else
+	return 1;
+#endif
+}
+
+#ifndef __STDC_NO_THREADS__
+struct worker {
+	void (*function)(size_t index, void *context);
+	void *context;
+	size_t count;
+	atomic_size_t next;
+};
+static int worker_run(void *argument) {
+	struct worker *worker = argument;
+
+	// indices are handed out one at a time, so uneven work items still balance across threads
+	size_t index = 0;
+	while ((index = atomic_fetch_add(&worker->next, 1)) < worker->count) {
+		worker->function(index, worker->context);
+	}
+
+	return 0;
+}
+#endif
+
+void boolean_parallel_for(
+	size_t count,
+	void (*function)(size_t index, void *context),
+	void *context
+) {
+	assert(function != NULL);
+
+	size_t threads_count = boolean_parallel_threads_count();
+	if (threads_count > count) {
+		threads_count = count;
+	}
+
+#ifndef __STDC_NO_THREADS__
+	if (threads_count > 1) {
+		struct worker worker = {
+			.function = function,
+			.context = context,
+			.count = count,
+		};
+		atomic_init(&worker.next, 0);
+
+		// the calling thread is one of the workers
+		thrd_t *threads = malloc((threads_count - 1) * sizeof(*threads));
+		size_t started = 0;
+		if (threads != NULL) {
+			while (started < threads_count - 1 &&
+				   thrd_create(&threads[started], worker_run, &worker) == thrd_success) {
+				started++;
+			}
+		}
+
+		(void)worker_run(&worker);
+
+		for (size_t i = 0; i < started; i++) {
+			(void)thrd_join(threads[i], NULL);
+		}
+		free(threads);
+
+		return;
+	}
+#endif
+
+	for (size_t i = 0; i < count; i++) {
+		function(i, context);
+	}
+}
@@ -0,0 +1,318 @@
+#include <bool_tool/boolean_probability.h>
+
+#include <assert.h>
+#include <bool_tool/boolean_bdd.h>
+#include <bool_tool/boolean_lanes.h>
+#include <bool_tool/boolean_ordering.h>
+#include <bool_tool/boolean_rewrite.h>
+#include <bool_tool/boolean_variables.h>
+#include <stdlib.h>
+
+// up to this many variables, a part of the expression is evaluated over its whole truth table a
+// word of rows at a time, past it a decision diagram is built
+#define TRUTH_TABLE_VARIABLES_MAXIMUM 24
+
+#define BUDGET_CHECK_INTERVAL 1024
+
+static double boolean_probability_of(const double *probabilities, size_t index) {
+	return probabilities != NULL ? probabilities[index] : 0.5;
+}
+
+// sums the probability of the rows of the truth table where the expression is true, counting
+// them by popcount if every variable is equally likely to be true or false
+static struct boolean_status boolean_probability_from_truth_table(
+	const struct boolean_expression *expression,
+	const struct boolean_environment *support,
+	const double *probabilities,
+	struct boolean_budget *budget,
+	double *probability
+) {
+	struct boolean_lanes lanes = boolean_lanes_from_support(support);
+	assert(lanes.variables_count <= TRUTH_TABLE_VARIABLES_MAXIMUM);
+
+	size_t lanes_count = (size_t)1 << lanes.lane_variables_count;
+	double lane_weights[UINT64_C(1) << BOOLEAN_LANE_VARIABLES_COUNT];
+	for (size_t lane = 0; lane < lanes_count; lane++) {
+		lane_weights[lane] = 1.0;
+		for (size_t i = 0; i < lanes.lane_variables_count; i++) {
+			double variable_probability = boolean_probability_of(probabilities, lanes.indices[i]);
+			lane_weights[lane] *=
+				((lane >> i) & 1U) != 0 ? variable_probability : 1.0 - variable_probability;
+		}
+	}
+
+	uint64_t count = 0;
+	double sum = 0.0;
+	uint64_t words_count = boolean_lanes_words_count(&lanes);
+	for (uint64_t block = 0; block < words_count; block++) {
+		if (block % BUDGET_CHECK_INTERVAL == BUDGET_CHECK_INTERVAL - 1 &&
+			boolean_budget_expired(budget)) {
+			return boolean_status_failure("ran out of time while evaluating the truth table");
+		}
+
+		uint64_t word = boolean_lanes_evaluate(&lanes, expression, block);
+		if (probabilities == NULL) {
+			count += (uint64_t)__builtin_popcountll(word);
+			continue;
+		}
+
+		double block_weight = 1.0;
+		for (size_t i = lanes.lane_variables_count; i < lanes.variables_count; i++) {
+			size_t index = lanes.indices[i];
+			bool value = lanes.words[index] != 0;
+			block_weight *= value ? probabilities[index] : 1.0 - probabilities[index];
+		}
+
+		double block_sum = 0.0;
+		for (; word != 0; word &= word - 1U) {
+			block_sum += lane_weights[__builtin_ctzll(word)];
+		}
+		sum += block_weight * block_sum;
+	}
+
+	if (probabilities == NULL) {
+		*probability = (double)count / (double)(UINT64_C(1) << lanes.variables_count);
+	} else {
+		*probability = sum;
+	}
+
+	return boolean_status_success();
+}
+
+static struct boolean_status boolean_probability_from_bdd(
+	const struct boolean_expression *expression,
+	const double *probabilities,
+	struct boolean_budget *budget,
+	double *probability
+) {
+	struct boolean_variables variables = boolean_variables_order_from_expression(expression);
+	struct boolean_bdd bdd = boolean_bdd_new(&variables, budget);
+	boolean_variables_drop(&variables);
+
+	uint32_t node = BOOLEAN_BDD_FALSE;
+	struct boolean_status status = boolean_bdd_from_expression(&bdd, expression, &node);
+	if (status.type == boolean_status_type_success) {
+		*probability = boolean_bdd_probability(&bdd, node, probabilities);
+	}
+	boolean_bdd_drop(&bdd);
+
+	return status;
+}
+
+// handles a part of the expression that can't be split into independent parts
+static struct boolean_status boolean_probability_from_connected(
+	const struct boolean_expression *expression,
+	const struct boolean_environment *support,
+	const double *probabilities,
+	struct boolean_budget *budget,
+	double *probability
+) {
+	if (__builtin_popcountll(support->variables) <= TRUTH_TABLE_VARIABLES_MAXIMUM) {
+		return boolean_probability_from_truth_table(
+			expression,
+			support,
+			probabilities,
+			budget,
+			probability
+		);
+	}
+
+	return boolean_probability_from_bdd(expression, probabilities, budget, probability);
+}
+
+static size_t boolean_probability_find_group(size_t *parents, size_t operand) {
+	while (parents[operand] != operand) {
+		parents[operand] = parents[parents[operand]];
+		operand = parents[operand];
+	}
+	return operand;
+}
+
+static struct boolean_status boolean_probability_from_expression(
+	const struct boolean_expression *expression,
+	const double *probabilities,
+	struct boolean_budget *budget,
+	double *probability
+);
+
+// groups the operands of the operation by the variables they share, then combines the
+// probabilities of the groups, which are independent of each other
+static struct boolean_status boolean_probability_from_operation(
+	const struct boolean_expression *expression,
+	const double *probabilities,
+	struct boolean_budget *budget,
+	double *probability
+) {
+	const struct boolean_operation *operation = &expression->operation;
+	size_t operands_count = operation->operands_count;
+
+	struct boolean_environment *supports = malloc(operands_count * sizeof(*supports));
+	size_t *parents = malloc(operands_count * sizeof(*parents));
+	struct boolean_expression *members = malloc(operands_count * sizeof(*members));
+	assert(supports != NULL && parents != NULL && members != NULL);
+
+	for (size_t i = 0; i < operands_count; i++) {
+		supports[i] = boolean_environment_new();
+		boolean_variables_from_expression_(&operation->operands[i], &supports[i]);
+		parents[i] = i;
+	}
+	for (size_t i = 0; i < operands_count; i++) {
+		for (size_t j = 0; j < i; j++) {
+			if ((supports[i].variables & supports[j].variables) != 0) {
+				size_t group_1 = boolean_probability_find_group(parents, i);
+				size_t group_2 = boolean_probability_find_group(parents, j);
+				parents[group_1] = group_2;
+			}
+		}
+	}
+
+	struct boolean_status status = boolean_status_success();
+	double result = operation->type == boolean_operation_type_conjunction ? 1.0 : 0.0;
+	for (size_t i = 0; i < operands_count && status.type == boolean_status_type_success; i++) {
+		if (boolean_probability_find_group(parents, i) != i) {
+			continue;
+		}
+
+		// the group borrows its members, so it mustn't be dropped
+		struct boolean_environment support = boolean_environment_new();
+		size_t members_count = 0;
+		for (size_t j = 0; j < operands_count; j++) {
+			if (boolean_probability_find_group(parents, j) == i) {
+				members[members_count++] = operation->operands[j];
+				support.variables |= supports[j].variables;
+			}
+		}
+
+		double group_probability = 0.0;
+		if (members_count == 1) {
+			status = boolean_probability_from_expression(
+				&members[0],
+				probabilities,
+				budget,
+				&group_probability
+			);
+		} else {
+			struct boolean_expression group = {
+				.type = boolean_expression_type_operation,
+				.operation = { operation->type, members, members_count },
+			};
+			status = boolean_probability_from_connected(
+				&group,
+				&support,
+				probabilities,
+				budget,
+				&group_probability
+			);
+		}
+
+		switch (operation->type) {
+			case boolean_operation_type_conjunction: {
+				result *= group_probability;
+			} break;
+			case boolean_operation_type_disjunction: {
+				result = 1.0 - (1.0 - result) * (1.0 - group_probability);
+			} break;
+			case boolean_operation_type_exclusive_disjunction: {
+				result = result * (1.0 - group_probability) + group_probability * (1.0 - result);
+			} break;
+			case boolean_operation_type_negation: assert(false); break;
+		}
+	}
+
+	free(members);
+	free(parents);
+	free(supports);
+
+	*probability = result;
+	return status;
+}
+
+static struct boolean_status boolean_probability_from_expression(
+	const struct boolean_expression *expression,
+	const double *probabilities,
+	struct boolean_budget *budget,
+	double *probability
+) {
+	switch (expression->type) {
+		case boolean_expression_type_constant: {
+			*probability = expression->constant.value ? 1.0 : 0.0;
+		} break;
+		case boolean_expression_type_variable: {
+			size_t index = boolean_environment_variable_index(expression->variable.name);
+			*probability = boolean_probability_of(probabilities, index);
+		} break;
+		case boolean_expression_type_operation: {
+			if (expression->operation.type != boolean_operation_type_negation) {
+				return boolean_probability_from_operation(
+					expression,
+					probabilities,
+					budget,
+					probability
+				);
+			}
+
+			double operand_probability = 0.0;
+			struct boolean_status status = boolean_probability_from_expression(
+				&expression->operation.operands[0],
+				probabilities,
+				budget,
+				&operand_probability
+			);
+			*probability = 1.0 - operand_probability;
+			return status;
+		} break;
+	}
+
+	return boolean_status_success();
+}
+
+// the number of assignments to the variables of the expression that make it true, found without
+// listing them
+struct boolean_status boolean_expression_count_models(
+	const struct boolean_expression *expression,
+	struct boolean_budget *budget,
+	uint64_t *count
+) {
+	assert(expression != NULL && count != NULL);
+
+	struct boolean_environment support = boolean_environment_new();
+	boolean_variables_from_expression_(expression, &support);
+	size_t variables_count = (size_t)__builtin_popcountll(support.variables);
+
+	// with every variable equally likely, the probabilities are all multiples of a power of two
+	// no smaller than the number of rows, which a double represents exactly
+	double probability = 0.0;
+	struct boolean_status status =
+		boolean_expression_probability(expression, NULL, budget, &probability);
+	if (status.type != boolean_status_type_success) {
+		return status;
+	}
+
+	*count = (uint64_t)(probability * (double)(UINT64_C(1) << variables_count));
+	return boolean_status_success();
+}
+
+// the probability the expression is true when each variable is independently true with the
+// probability given for it, indexed by environment variable, or a half if none are given
+struct boolean_status boolean_expression_probability(
+	const struct boolean_expression *expression,
+	const double *probabilities,
+	struct boolean_budget *budget,
+	double *probability
+) {
+	assert(expression != NULL && probability != NULL);
+
+	struct boolean_expression rewritten = boolean_expression_clone(expression);
+	boolean_expression_rewrite(&rewritten);
+
+	double result = 0.0;
+	struct boolean_status status =
+		boolean_probability_from_expression(&rewritten, probabilities, budget, &result);
+	boolean_expression_drop(&rewritten);
+
+	if (status.type == boolean_status_type_success) {
+		*probability = result;
+	}
+
+	return status;
+}
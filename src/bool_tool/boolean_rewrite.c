@@ -0,0 +1,427 @@
+#include <bool_tool/boolean_rewrite.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+// above this many pairs of operands, only absorption by single operands is looked for, since the
+// general check compares every pair of products
+#define ABSORPTION_PAIRS_MAXIMUM ((size_t)1 << 20)
+
+static int boolean_expression_compare_(const void *expression_1, const void *expression_2) {
+	return boolean_expression_compare(expression_1, expression_2);
+}
+
+static bool boolean_expression_is_literal(const struct boolean_expression *expression) {
+	return expression->type == boolean_expression_type_variable ||
+		   (expression->type == boolean_expression_type_operation &&
+			expression->operation.type == boolean_operation_type_negation &&
+			expression->operation.operands[0].type == boolean_expression_type_variable);
+}
+
+static bool boolean_expression_is_complement(
+	const struct boolean_expression *literal_1,
+	const struct boolean_expression *literal_2
+) {
+	if (!boolean_expression_is_literal(literal_1) || !boolean_expression_is_literal(literal_2)) {
+		return false;
+	}
+
+	bool negated_1 = literal_1->type == boolean_expression_type_operation;
+	bool negated_2 = literal_2->type == boolean_expression_type_operation;
+	char name_1 = negated_1 ? literal_1->operation.operands[0].variable.name
+							: literal_1->variable.name;
+	char name_2 = negated_2 ? literal_2->operation.operands[0].variable.name
+							: literal_2->variable.name;
+
+	return name_1 == name_2 && negated_1 != negated_2;
+}
+
+// the operands of an operation of the given type, a non-matching expression is its only operand
+static const struct boolean_expression *boolean_expression_operands_of(
+	const struct boolean_expression *expression,
+	enum boolean_operation_type type,
+	size_t *operands_count
+) {
+	if (expression->type == boolean_expression_type_operation &&
+		expression->operation.type == type) {
+		*operands_count = expression->operation.operands_count;
+		return expression->operation.operands;
+	}
+
+	*operands_count = 1;
+	return expression;
+}
+
+// whether every operand of the first sorted list also appears in the second sorted list
+static bool boolean_expression_operands_subset(
+	const struct boolean_expression *operands_1,
+	size_t operands_1_count,
+	const struct boolean_expression *operands_2,
+	size_t operands_2_count
+) {
+	size_t j = 0;
+	for (size_t i = 0; i < operands_1_count; i++) {
+		while (j < operands_2_count &&
+			   boolean_expression_compare(&operands_2[j], &operands_1[i]) < 0) {
+			j++;
+		}
+		if (j == operands_2_count ||
+			boolean_expression_compare(&operands_2[j], &operands_1[i]) != 0) {
+			return false;
+		}
+		j++;
+	}
+
+	return true;
+}
+
+static void boolean_expression_rewrite_negation(struct boolean_expression *expression) {
+	struct boolean_expression *operand = &expression->operation.operands[0];
+
+	switch (operand->type) {
+		case boolean_expression_type_constant: {
+			bool value = !operand->constant.value;
+			boolean_expression_drop(expression);
+			*expression = boolean_expression_new_constant(value);
+		} break;
+		case boolean_expression_type_variable: break;
+		case boolean_expression_type_operation: {
+			struct boolean_expression inner = *operand;
+			free(expression->operation.operands);
+
+			switch (inner.operation.type) {
+				// double negation
+				case boolean_operation_type_negation: {
+					*expression = inner.operation.operands[0];
+					free(inner.operation.operands);
+				} break;
+				// De Morgan's laws
+				case boolean_operation_type_conjunction:
+				case boolean_operation_type_disjunction: {
+					for (size_t i = 0; i < inner.operation.operands_count; i++) {
+						inner.operation.operands[i] = boolean_expression_new_operation(
+							boolean_operation_type_negation,
+							inner.operation.operands[i]
+						);
+					}
+					inner.operation.type =
+						inner.operation.type == boolean_operation_type_conjunction
+							? boolean_operation_type_disjunction
+							: boolean_operation_type_conjunction;
+					*expression = inner;
+				} break;
+				// negating any single operand negates an exclusive disjunction
+				case boolean_operation_type_exclusive_disjunction: {
+					inner.operation.operands[0] = boolean_expression_new_operation(
+						boolean_operation_type_negation,
+						inner.operation.operands[0]
+					);
+					*expression = inner;
+				} break;
+			}
+
+			boolean_expression_rewrite(expression);
+		} break;
+	}
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+static void boolean_expression_rewrite_operation(struct boolean_expression *expression) {
+	enum boolean_operation_type type = expression->operation.type;
+	enum boolean_operation_type dual_type = type == boolean_operation_type_conjunction
+												? boolean_operation_type_disjunction
+												: boolean_operation_type_conjunction;
+	// the constant that can be dropped from the operands, and the one that dominates them
+	bool identity = type == boolean_operation_type_conjunction;
+
+	struct boolean_expression *operands = expression->operation.operands;
+	size_t operands_count = expression->operation.operands_count;
+
+	size_t flattened_count = 0;
+	for (size_t i = 0; i < operands_count; i++) {
+		boolean_expression_rewrite(&operands[i]);
+
+		size_t count = 0;
+		(void)boolean_expression_operands_of(&operands[i], type, &count);
+		flattened_count += count;
+	}
+
+	// flatten nested operations of the same type (associativity)
+	if (flattened_count != operands_count) {
+		struct boolean_expression *flattened = malloc(flattened_count * sizeof(*flattened));
+		assert(flattened != NULL);
+
+		size_t k = 0;
+		for (size_t i = 0; i < operands_count; i++) {
+			if (operands[i].type == boolean_expression_type_operation &&
+				operands[i].operation.type == type) {
+				memcpy(
+					&flattened[k],
+					operands[i].operation.operands,
+					operands[i].operation.operands_count * sizeof(*flattened)
+				);
+				k += operands[i].operation.operands_count;
+				free(operands[i].operation.operands);
+			} else {
+				flattened[k++] = operands[i];
+			}
+		}
+
+		free(operands);
+		operands = flattened;
+		operands_count = flattened_count;
+	}
+
+	// constant folding
+	bool dominated = false;
+	size_t k = 0;
+	for (size_t i = 0; i < operands_count; i++) {
+		if (operands[i].type == boolean_expression_type_constant) {
+			dominated |= operands[i].constant.value != identity;
+		} else {
+			operands[k++] = operands[i];
+		}
+	}
+	operands_count = k;
+
+	if (!dominated) {
+		qsort(operands, operands_count, sizeof(*operands), boolean_expression_compare_);
+
+		// idempotence, equal operands are adjacent after sorting
+		k = 0;
+		for (size_t i = 0; i < operands_count; i++) {
+			if (k != 0 && boolean_expression_compare(&operands[k - 1], &operands[i]) == 0) {
+				boolean_expression_drop(&operands[i]);
+			} else {
+				operands[k++] = operands[i];
+			}
+		}
+		operands_count = k;
+
+		// complementation, a literal is directly followed by its negation after sorting
+		for (size_t i = 1; i < operands_count && !dominated; i++) {
+			dominated = boolean_expression_is_complement(&operands[i - 1], &operands[i]);
+		}
+	}
+
+	if (dominated) {
+		for (size_t i = 0; i < operands_count; i++) {
+			boolean_expression_drop(&operands[i]);
+		}
+		free(operands);
+		*expression = boolean_expression_new_constant(!identity);
+		return;
+	}
+
+	// absorption, an operand of the dual type is redundant if it contains all the operands of
+	// another operand, e.g. x + xy = x and x(x + y) = x
+	bool *absorbed = calloc(operands_count, sizeof(*absorbed));
+	assert(absorbed != NULL || operands_count == 0);
+
+	bool pairwise = operands_count <= ABSORPTION_PAIRS_MAXIMUM / (operands_count + 1);
+	for (size_t i = 0; i < operands_count; i++) {
+		if (operands[i].type != boolean_expression_type_operation ||
+			operands[i].operation.type != dual_type) {
+			continue;
+		}
+
+		if (pairwise) {
+			for (size_t j = 0; j < operands_count && !absorbed[i]; j++) {
+				if (j == i || absorbed[j]) {
+					continue;
+				}
+
+				size_t subset_count = 0;
+				const struct boolean_expression *subset =
+					boolean_expression_operands_of(&operands[j], dual_type, &subset_count);
+				absorbed[i] = boolean_expression_operands_subset(
+					subset,
+					subset_count,
+					operands[i].operation.operands,
+					operands[i].operation.operands_count
+				);
+			}
+		} else {
+			for (size_t j = 0; j < operands[i].operation.operands_count && !absorbed[i]; j++) {
+				absorbed[i] = bsearch(
+								  &operands[i].operation.operands[j],
+								  operands,
+								  operands_count,
+								  sizeof(*operands),
+								  boolean_expression_compare_
+							  ) != NULL;
+			}
+		}
+	}
+
+	k = 0;
+	for (size_t i = 0; i < operands_count; i++) {
+		if (absorbed[i]) {
+			boolean_expression_drop(&operands[i]);
+		} else {
+			operands[k++] = operands[i];
+		}
+	}
+	operands_count = k;
+	free(absorbed);
+
+	*expression = boolean_expression_new_operation_from_operands(type, operands, operands_count);
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+static void boolean_expression_rewrite_exclusive_disjunction(
+	struct boolean_expression *expression
+) {
+	struct boolean_expression *operands = expression->operation.operands;
+	size_t operands_count = expression->operation.operands_count;
+
+	size_t flattened_count = 0;
+	for (size_t i = 0; i < operands_count; i++) {
+		boolean_expression_rewrite(&operands[i]);
+
+		size_t count = 0;
+		(void)boolean_expression_operands_of(
+			&operands[i],
+			boolean_operation_type_exclusive_disjunction,
+			&count
+		);
+		flattened_count += count;
+	}
+
+	// flatten nested exclusive disjunctions (associativity)
+	if (flattened_count != operands_count) {
+		struct boolean_expression *flattened = malloc(flattened_count * sizeof(*flattened));
+		assert(flattened != NULL);
+
+		size_t k = 0;
+		for (size_t i = 0; i < operands_count; i++) {
+			if (operands[i].type == boolean_expression_type_operation &&
+				operands[i].operation.type == boolean_operation_type_exclusive_disjunction) {
+				memcpy(
+					&flattened[k],
+					operands[i].operation.operands,
+					operands[i].operation.operands_count * sizeof(*flattened)
+				);
+				k += operands[i].operation.operands_count;
+				free(operands[i].operation.operands);
+			} else {
+				flattened[k++] = operands[i];
+			}
+		}
+
+		free(operands);
+		operands = flattened;
+		operands_count = flattened_count;
+	}
+
+	// constants and negations of literals only contribute to the parity of the result
+	bool parity = false;
+	size_t k = 0;
+	for (size_t i = 0; i < operands_count; i++) {
+		if (operands[i].type == boolean_expression_type_constant) {
+			parity ^= operands[i].constant.value;
+		} else if (boolean_expression_is_literal(&operands[i]) &&
+				   operands[i].type == boolean_expression_type_operation) {
+			struct boolean_expression variable = operands[i].operation.operands[0];
+			free(operands[i].operation.operands);
+			operands[k++] = variable;
+			parity = !parity;
+		} else {
+			operands[k++] = operands[i];
+		}
+	}
+	operands_count = k;
+
+	// x ^ x = 0, equal operands are adjacent after sorting
+	qsort(operands, operands_count, sizeof(*operands), boolean_expression_compare_);
+	k = 0;
+	for (size_t i = 0; i < operands_count; i++) {
+		if (k != 0 && boolean_expression_compare(&operands[k - 1], &operands[i]) == 0) {
+			boolean_expression_drop(&operands[--k]);
+			boolean_expression_drop(&operands[i]);
+		} else {
+			operands[k++] = operands[i];
+		}
+	}
+	operands_count = k;
+
+	*expression = boolean_expression_new_operation_from_operands(
+		boolean_operation_type_exclusive_disjunction,
+		operands,
+		operands_count
+	);
+
+	if (parity) {
+		// negating the first operand rather than the whole operation, as negating the operation
+		// would be rewritten into exactly that
+		struct boolean_expression *negated = expression;
+		if (expression->type == boolean_expression_type_operation &&
+			expression->operation.type == boolean_operation_type_exclusive_disjunction) {
+			negated = &expression->operation.operands[0];
+		}
+		*negated = boolean_expression_new_operation(boolean_operation_type_negation, *negated);
+		boolean_expression_rewrite(negated);
+	}
+}
+
+void boolean_expression_rewrite(struct boolean_expression *expression) {
+	assert(expression != NULL);
+
+	if (expression->type != boolean_expression_type_operation) {
+		return;
+	}
+
+	switch (expression->operation.type) {
+		case boolean_operation_type_negation: {
+			boolean_expression_rewrite_negation(expression);
+		} break;
+		case boolean_operation_type_conjunction:
+		case boolean_operation_type_disjunction: {
+			boolean_expression_rewrite_operation(expression);
+		} break;
+		case boolean_operation_type_exclusive_disjunction: {
+			boolean_expression_rewrite_exclusive_disjunction(expression);
+		} break;
+	}
+}
+
+bool boolean_expression_is_read_once_sum_of_products(const struct boolean_expression *expression) {
+	assert(expression != NULL);
+
+	if (expression->type == boolean_expression_type_constant) {
+		return true;
+	}
+
+	struct boolean_environment seen = boolean_environment_new();
+
+	size_t products_count = 0;
+	const struct boolean_expression *products = boolean_expression_operands_of(
+		expression,
+		boolean_operation_type_disjunction,
+		&products_count
+	);
+	for (size_t i = 0; i < products_count; i++) {
+		size_t literals_count = 0;
+		const struct boolean_expression *literals = boolean_expression_operands_of(
+			&products[i],
+			boolean_operation_type_conjunction,
+			&literals_count
+		);
+		for (size_t j = 0; j < literals_count; j++) {
+			if (!boolean_expression_is_literal(&literals[j])) {
+				return false;
+			}
+
+			char name = literals[j].type == boolean_expression_type_variable
+							? literals[j].variable.name
+							: literals[j].operation.operands[0].variable.name;
+			if (boolean_environment_get_variable(&seen, name)) {
+				return false;
+			}
+			boolean_environment_set_variable(&seen, name, true);
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,649 @@
+#include <bool_tool/boolean_sat.h>
+
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_REASON SIZE_MAX
+#define UNASSIGNED ((int8_t)-1)
+
+// how many conflicts happen between checks of the budget's deadline, and how many conflicts the
+// unit of the restart sequence is
+#define BUDGET_CHECK_INTERVAL 256
+#define RESTART_INTERVAL 100
+
+#define ACTIVITY_DECAY 0.95
+#define ACTIVITY_MAXIMUM 1e100
+
+// internally, a literal is twice its variable, counting from 0, plus one if it's negated
+static uint32_t literal_from_external(int literal) {
+	assert(literal != 0 && literal != INT_MIN);
+	uint32_t variable = (uint32_t)(literal > 0 ? literal : -literal) - 1U;
+	return 2U * variable + (literal < 0);
+}
+static size_t literal_variable(uint32_t literal) {
+	return literal / 2U;
+}
+static uint32_t literal_negate(uint32_t literal) {
+	return literal ^ 1U;
+}
+
+// 1 if the literal is true, 0 if it's false, and UNASSIGNED otherwise
+static int8_t boolean_sat_literal_value(const struct boolean_sat *sat, uint32_t literal) {
+	int8_t value = sat->values[literal_variable(literal)];
+	if (value == UNASSIGNED) {
+		return UNASSIGNED;
+	}
+	return (int8_t)(value ^ (int8_t)(literal & 1U));
+}
+
+static void boolean_sat_watches_push(struct boolean_sat_watches *watches, size_t clause) {
+	if (watches->length == watches->capacity) {
+		watches->capacity = watches->capacity == 0 ? 4 : watches->capacity * 2;
+		watches->data = realloc(watches->data, watches->capacity * sizeof(*watches->data));
+		assert(watches->data != NULL);
+	}
+	watches->data[watches->length++] = clause;
+}
+
+static bool boolean_sat_heap_less(const struct boolean_sat *sat, size_t i, size_t j) {
+	return sat->activities[sat->heap[i]] > sat->activities[sat->heap[j]];
+}
+static void boolean_sat_heap_swap(struct boolean_sat *sat, size_t i, size_t j) {
+	size_t variable = sat->heap[i];
+	sat->heap[i] = sat->heap[j];
+	sat->heap[j] = variable;
+	sat->heap_positions[sat->heap[i]] = i;
+	sat->heap_positions[sat->heap[j]] = j;
+}
+static void boolean_sat_heap_up(struct boolean_sat *sat, size_t i) {
+	while (i != 0 && boolean_sat_heap_less(sat, i, (i - 1) / 2)) {
+		boolean_sat_heap_swap(sat, i, (i - 1) / 2);
+		i = (i - 1) / 2;
+	}
+}
+static void boolean_sat_heap_down(struct boolean_sat *sat, size_t i) {
+	while (1) {
+		size_t best = i;
+		size_t left = 2 * i + 1;
+		size_t right = 2 * i + 2;
+		if (left < sat->heap_length && boolean_sat_heap_less(sat, left, best)) {
+			best = left;
+		}
+		if (right < sat->heap_length && boolean_sat_heap_less(sat, right, best)) {
+			best = right;
+		}
+		if (best == i) {
+			break;
+		}
+		boolean_sat_heap_swap(sat, i, best);
+		i = best;
+	}
+}
+static void boolean_sat_heap_insert(struct boolean_sat *sat, size_t variable) {
+	if (sat->heap_positions[variable] != SIZE_MAX) {
+		return;
+	}
+	sat->heap[sat->heap_length] = variable;
+	sat->heap_positions[variable] = sat->heap_length;
+	boolean_sat_heap_up(sat, sat->heap_length++);
+}
+static size_t boolean_sat_heap_pop(struct boolean_sat *sat) {
+	assert(sat->heap_length != 0);
+
+	size_t variable = sat->heap[0];
+	boolean_sat_heap_swap(sat, 0, --sat->heap_length);
+	sat->heap_positions[variable] = SIZE_MAX;
+	boolean_sat_heap_down(sat, 0);
+	return variable;
+}
+
+// raises the variable's activity, so variables involved in recent conflicts are decided first
+static void boolean_sat_bump(struct boolean_sat *sat, size_t variable) {
+	sat->activities[variable] += sat->activity_increment;
+	if (sat->activities[variable] > ACTIVITY_MAXIMUM) {
+		for (size_t i = 0; i < sat->variables_count; i++) {
+			sat->activities[i] /= ACTIVITY_MAXIMUM;
+		}
+		sat->activity_increment /= ACTIVITY_MAXIMUM;
+	}
+	if (sat->heap_positions[variable] != SIZE_MAX) {
+		boolean_sat_heap_up(sat, sat->heap_positions[variable]);
+	}
+}
+
+void boolean_sat_drop(struct boolean_sat *sat) {
+	assert(sat != NULL);
+
+	free(sat->clauses.data);
+	for (size_t i = 0; i < 2 * sat->variables_count; i++) {
+		free(sat->watches[i].data);
+	}
+	free(sat->watches);
+	free(sat->values);
+	free(sat->phases);
+	free(sat->model);
+	free(sat->seen);
+	free(sat->levels);
+	free(sat->reasons);
+	free(sat->trail);
+	free(sat->trail_limits);
+	free(sat->activities);
+	free(sat->heap);
+	free(sat->heap_positions);
+}
+
+struct boolean_sat boolean_sat_new(void) {
+	return (struct boolean_sat){
+		.variables_count = 0,
+		.variables_capacity = 0,
+		.clauses = { .data = NULL, .length = 0, .capacity = 0 },
+		.watches = NULL,
+		.values = NULL,
+		.phases = NULL,
+		.model = NULL,
+		.seen = NULL,
+		.levels = NULL,
+		.reasons = NULL,
+		.trail = NULL,
+		.trail_length = 0,
+		.trail_limits = NULL,
+		.level = 0,
+		.propagated = 0,
+		.activities = NULL,
+		.activity_increment = 1.0,
+		.heap = NULL,
+		.heap_length = 0,
+		.heap_positions = NULL,
+		.true_literal = 0,
+		.inconsistent = false,
+	};
+}
+
+int boolean_sat_new_variable(struct boolean_sat *sat) {
+	assert(sat != NULL);
+	assert(sat->variables_count < INT_MAX);
+
+	if (sat->variables_count == sat->variables_capacity) {
+		size_t capacity = sat->variables_capacity == 0 ? 16 : sat->variables_capacity * 2;
+
+#define GROW(field)                                                                                \
+	do {                                                                                           \
+		sat->field = realloc(sat->field, capacity * sizeof(*sat->field));                          \
+		assert(sat->field != NULL);                                                                \
+	} while (0)
+		GROW(values);
+		GROW(phases);
+		GROW(model);
+		GROW(seen);
+		GROW(levels);
+		GROW(reasons);
+		GROW(trail);
+		GROW(trail_limits);
+		GROW(activities);
+		GROW(heap);
+		GROW(heap_positions);
+#undef GROW
+
+		sat->watches = realloc(sat->watches, 2 * capacity * sizeof(*sat->watches));
+		assert(sat->watches != NULL);
+
+		sat->variables_capacity = capacity;
+	}
+
+	size_t variable = sat->variables_count++;
+	sat->values[variable] = UNASSIGNED;
+	sat->phases[variable] = false;
+	sat->model[variable] = false;
+	sat->seen[variable] = false;
+	sat->levels[variable] = 0;
+	sat->reasons[variable] = NO_REASON;
+	sat->activities[variable] = 0.0;
+	sat->heap_positions[variable] = SIZE_MAX;
+	sat->watches[2 * variable] = (struct boolean_sat_watches){ 0 };
+	sat->watches[2 * variable + 1] = (struct boolean_sat_watches){ 0 };
+	boolean_sat_heap_insert(sat, variable);
+
+	return (int)variable + 1;
+}
+
+static void boolean_sat_assign(struct boolean_sat *sat, uint32_t literal, size_t reason) {
+	size_t variable = literal_variable(literal);
+	assert(sat->values[variable] == UNASSIGNED);
+
+	sat->values[variable] = (int8_t)((literal & 1U) == 0);
+	sat->levels[variable] = sat->level;
+	sat->reasons[variable] = reason;
+	sat->trail[sat->trail_length++] = literal;
+}
+
+static void boolean_sat_backtrack(struct boolean_sat *sat, size_t level) {
+	if (sat->level <= level) {
+		return;
+	}
+
+	for (size_t i = sat->trail_length; i > sat->trail_limits[level]; i--) {
+		size_t variable = literal_variable(sat->trail[i - 1]);
+		sat->phases[variable] = sat->values[variable] == 1;
+		sat->values[variable] = UNASSIGNED;
+		sat->reasons[variable] = NO_REASON;
+		boolean_sat_heap_insert(sat, variable);
+	}
+	sat->trail_length = sat->trail_limits[level];
+	sat->propagated = sat->trail_length;
+	sat->level = level;
+}
+
+static void boolean_sat_new_level(struct boolean_sat *sat) {
+	sat->trail_limits[sat->level++] = sat->trail_length;
+}
+
+// appends a clause of at least two literals and watches its first two, returning its reference
+static size_t boolean_sat_attach(struct boolean_sat *sat, const uint32_t *literals, size_t count) {
+	assert(count >= 2);
+
+	if (sat->clauses.capacity - sat->clauses.length < count + 1) {
+		size_t capacity = sat->clauses.capacity == 0 ? 64 : sat->clauses.capacity;
+		while (capacity - sat->clauses.length < count + 1) {
+			capacity *= 2;
+		}
+		sat->clauses.data = realloc(sat->clauses.data, capacity * sizeof(*sat->clauses.data));
+		assert(sat->clauses.data != NULL);
+		sat->clauses.capacity = capacity;
+	}
+
+	size_t clause = sat->clauses.length;
+	sat->clauses.data[sat->clauses.length++] = (uint32_t)count;
+	memcpy(&sat->clauses.data[sat->clauses.length], literals, count * sizeof(*literals));
+	sat->clauses.length += count;
+
+	boolean_sat_watches_push(&sat->watches[literals[0]], clause);
+	boolean_sat_watches_push(&sat->watches[literals[1]], clause);
+
+	return clause;
+}
+
+// assigns every literal implied by the trail, returning the clause that conflicts, if any
+static size_t boolean_sat_propagate(struct boolean_sat *sat) {
+	while (sat->propagated < sat->trail_length) {
+		uint32_t false_literal = literal_negate(sat->trail[sat->propagated++]);
+		struct boolean_sat_watches *watches = &sat->watches[false_literal];
+
+		size_t i = 0;
+		size_t j = 0;
+		while (i < watches->length) {
+			size_t clause = watches->data[i++];
+			uint32_t count = sat->clauses.data[clause];
+			uint32_t *literals = &sat->clauses.data[clause + 1];
+
+			// the false literal is kept second, so the first is the one that may be implied
+			if (literals[0] == false_literal) {
+				literals[0] = literals[1];
+				literals[1] = false_literal;
+			}
+
+			if (boolean_sat_literal_value(sat, literals[0]) == 1) {
+				watches->data[j++] = clause;
+				continue;
+			}
+
+			bool moved = false;
+			for (uint32_t k = 2; k < count; k++) {
+				if (boolean_sat_literal_value(sat, literals[k]) != 0) {
+					literals[1] = literals[k];
+					literals[k] = false_literal;
+					boolean_sat_watches_push(&sat->watches[literals[1]], clause);
+					moved = true;
+					break;
+				}
+			}
+			if (moved) {
+				continue;
+			}
+
+			watches->data[j++] = clause;
+			if (boolean_sat_literal_value(sat, literals[0]) == 0) {
+				while (i < watches->length) {
+					watches->data[j++] = watches->data[i++];
+				}
+				watches->length = j;
+				return clause;
+			}
+			boolean_sat_assign(sat, literals[0], clause);
+		}
+		watches->length = j;
+	}
+
+	return NO_REASON;
+}
+
+// derives the first unique implication point clause of the conflict into the learnt literals,
+// with the asserting literal first and a literal of the backjump level second, and returns its
+// length
+static size_t boolean_sat_analyze(struct boolean_sat *sat, size_t conflict, uint32_t *learnt) {
+	size_t learnt_count = 1;
+	size_t pending = 0;
+	uint32_t implied = 0;
+	bool has_implied = false;
+	size_t index = sat->trail_length;
+	size_t clause = conflict;
+
+	do {
+		assert(clause != NO_REASON);
+		uint32_t count = sat->clauses.data[clause];
+		const uint32_t *literals = &sat->clauses.data[clause + 1];
+
+		// the first literal of a reason is the one it implied
+		for (uint32_t k = has_implied ? 1 : 0; k < count; k++) {
+			size_t variable = literal_variable(literals[k]);
+			if (sat->seen[variable] || sat->levels[variable] == 0) {
+				continue;
+			}
+
+			sat->seen[variable] = true;
+			boolean_sat_bump(sat, variable);
+			if (sat->levels[variable] == sat->level) {
+				pending++;
+			} else {
+				learnt[learnt_count++] = literals[k];
+			}
+		}
+
+		while (!sat->seen[literal_variable(sat->trail[index - 1])]) {
+			index--;
+		}
+		implied = sat->trail[--index];
+		has_implied = true;
+		clause = sat->reasons[literal_variable(implied)];
+		sat->seen[literal_variable(implied)] = false;
+		pending--;
+	} while (pending > 0);
+
+	learnt[0] = literal_negate(implied);
+
+	size_t second = 1;
+	for (size_t k = 1; k < learnt_count; k++) {
+		sat->seen[literal_variable(learnt[k])] = false;
+		if (sat->levels[literal_variable(learnt[k])] >
+			sat->levels[literal_variable(learnt[second])]) {
+			second = k;
+		}
+	}
+	if (learnt_count > 1) {
+		uint32_t literal = learnt[1];
+		learnt[1] = learnt[second];
+		learnt[second] = literal;
+	}
+
+	return learnt_count;
+}
+
+// clauses can only be added while no decision is made
+void boolean_sat_add_clause(struct boolean_sat *sat, const int *literals, size_t literals_count) {
+	assert(sat != NULL && (literals != NULL || literals_count == 0));
+	assert(sat->level == 0);
+
+	if (sat->inconsistent) {
+		return;
+	}
+
+	uint32_t *clause = malloc((literals_count + 1) * sizeof(*clause));
+	assert(clause != NULL);
+
+	// literals false at the top level are left out, and satisfied clauses dropped
+	size_t count = 0;
+	for (size_t i = 0; i < literals_count; i++) {
+		uint32_t literal = literal_from_external(literals[i]);
+		assert(literal_variable(literal) < sat->variables_count);
+
+		int8_t value = boolean_sat_literal_value(sat, literal);
+		if (value == 0) {
+			continue;
+		}
+
+		// a variable already seen is either repeated, or appears in both polarities, which
+		// satisfies the clause
+		bool satisfied = value == 1;
+		if (!satisfied && sat->seen[literal_variable(literal)]) {
+			for (size_t k = 0; k < count && !satisfied; k++) {
+				satisfied = clause[k] == literal_negate(literal);
+			}
+			if (!satisfied) {
+				continue;
+			}
+		}
+		if (satisfied) {
+			for (size_t k = 0; k < count; k++) {
+				sat->seen[literal_variable(clause[k])] = false;
+			}
+			free(clause);
+			return;
+		}
+
+		sat->seen[literal_variable(literal)] = true;
+		clause[count++] = literal;
+	}
+	for (size_t k = 0; k < count; k++) {
+		sat->seen[literal_variable(clause[k])] = false;
+	}
+
+	if (count == 0) {
+		sat->inconsistent = true;
+	} else if (count == 1) {
+		boolean_sat_assign(sat, clause[0], NO_REASON);
+		sat->inconsistent = boolean_sat_propagate(sat) != NO_REASON;
+	} else {
+		(void)boolean_sat_attach(sat, clause, count);
+	}
+
+	free(clause);
+}
+
+// the Tseitin encoding of the expression, returning a literal equivalent to it, the variables
+// map each environment variable to its solver variable, 0 until it's first used
+int boolean_sat_add_expression(
+	struct boolean_sat *sat,
+	const struct boolean_expression *expression,
+	int *variables
+) {
+	assert(sat != NULL && expression != NULL && variables != NULL);
+
+	switch (expression->type) {
+		case boolean_expression_type_constant: {
+			if (sat->true_literal == 0) {
+				sat->true_literal = boolean_sat_new_variable(sat);
+				boolean_sat_add_clause(sat, &sat->true_literal, 1);
+			}
+			return expression->constant.value ? sat->true_literal : -sat->true_literal;
+		} break;
+		case boolean_expression_type_variable: {
+			size_t index = boolean_environment_variable_index(expression->variable.name);
+			if (variables[index] == 0) {
+				variables[index] = boolean_sat_new_variable(sat);
+			}
+			return variables[index];
+		} break;
+		case boolean_expression_type_operation: {
+			const struct boolean_expression *operands = expression->operation.operands;
+			size_t operands_count = expression->operation.operands_count;
+			switch (expression->operation.type) {
+				case boolean_operation_type_conjunction:
+				case boolean_operation_type_disjunction: {
+					// a disjunction is encoded as the negated conjunction of negated operands
+					int sign = expression->operation.type == boolean_operation_type_conjunction
+								   ? 1
+								   : -1;
+
+					int *clause = malloc((operands_count + 1) * sizeof(*clause));
+					assert(clause != NULL);
+					for (size_t i = 0; i < operands_count; i++) {
+						int operand = boolean_sat_add_expression(sat, &operands[i], variables);
+						clause[i + 1] = sign * operand;
+					}
+
+					int output = boolean_sat_new_variable(sat);
+					for (size_t i = 0; i < operands_count; i++) {
+						int implication[] = { -output, clause[i + 1] };
+						boolean_sat_add_clause(sat, implication, 2);
+						clause[i + 1] = -clause[i + 1];
+					}
+					clause[0] = output;
+					boolean_sat_add_clause(sat, clause, operands_count + 1);
+					free(clause);
+
+					return sign * output;
+				}
+				case boolean_operation_type_exclusive_disjunction: {
+					int output = boolean_sat_add_expression(sat, &operands[0], variables);
+					for (size_t i = 1; i < operands_count; i++) {
+						int operand = boolean_sat_add_expression(sat, &operands[i], variables);
+						int parity = boolean_sat_new_variable(sat);
+						int clauses[][3] = {
+							{ -parity, output, operand },
+							{ -parity, -output, -operand },
+							{ parity, -output, operand },
+							{ parity, output, -operand },
+						};
+						for (size_t k = 0; k < sizeof(clauses) / sizeof(*clauses); k++) {
+							boolean_sat_add_clause(sat, clauses[k], 3);
+						}
+						output = parity;
+					}
+					return output;
+				}
+				case boolean_operation_type_negation: {
+					return -boolean_sat_add_expression(sat, &operands[0], variables);
+				}
+			}
+		} break;
+	}
+
+	return 0;
+}
+
+// the restart intervals follow the Luby sequence 1, 1, 2, 1, 1, 2, 4, ...
+static size_t luby(size_t index) {
+	size_t size = 1;
+	size_t power = 1;
+	while (size < index + 1) {
+		size = 2 * size + 1;
+		power *= 2;
+	}
+	while (size - 1 != index) {
+		size = (size - 1) / 2;
+		power /= 2;
+		index %= size;
+	}
+	return power;
+}
+
+// solves under the assumed literals, unknown is only returned once the budget runs out
+enum boolean_sat_result boolean_sat_solve(
+	struct boolean_sat *sat,
+	const int *assumptions,
+	size_t assumptions_count,
+	struct boolean_budget *budget
+) {
+	assert(sat != NULL && (assumptions != NULL || assumptions_count == 0));
+
+	if (sat->inconsistent) {
+		return boolean_sat_result_unsatisfiable;
+	}
+
+	uint32_t *learnt = malloc((sat->variables_count + 1) * sizeof(*learnt));
+	assert(learnt != NULL);
+
+	// an assumption that already holds still takes a level, so there can be more levels than
+	// variables
+	sat->trail_limits = realloc(
+		sat->trail_limits,
+		(sat->variables_capacity + assumptions_count + 1) * sizeof(*sat->trail_limits)
+	);
+	assert(sat->trail_limits != NULL);
+
+	enum boolean_sat_result result = boolean_sat_result_unknown;
+	size_t conflicts = 0;
+	size_t restarts = 0;
+	size_t restart_limit = RESTART_INTERVAL * luby(restarts);
+	while (1) {
+		size_t conflict = boolean_sat_propagate(sat);
+		if (conflict != NO_REASON) {
+			if (sat->level == 0) {
+				sat->inconsistent = true;
+				result = boolean_sat_result_unsatisfiable;
+				break;
+			}
+
+			size_t learnt_count = boolean_sat_analyze(sat, conflict, learnt);
+			size_t level = learnt_count > 1 ? sat->levels[literal_variable(learnt[1])] : 0;
+			boolean_sat_backtrack(sat, level);
+			if (learnt_count == 1) {
+				boolean_sat_assign(sat, learnt[0], NO_REASON);
+			} else {
+				boolean_sat_assign(sat, learnt[0], boolean_sat_attach(sat, learnt, learnt_count));
+			}
+			sat->activity_increment /= ACTIVITY_DECAY;
+
+			conflicts++;
+			if (conflicts % BUDGET_CHECK_INTERVAL == 0 && boolean_budget_expired(budget)) {
+				break;
+			}
+			if (conflicts >= restart_limit) {
+				boolean_sat_backtrack(sat, 0);
+				restart_limit = conflicts + RESTART_INTERVAL * luby(++restarts);
+			}
+			continue;
+		}
+
+		// assumptions are decided first, one level each
+		if (sat->level < assumptions_count) {
+			uint32_t literal = literal_from_external(assumptions[sat->level]);
+			int8_t value = boolean_sat_literal_value(sat, literal);
+			if (value == 0) {
+				result = boolean_sat_result_unsatisfiable;
+				break;
+			}
+
+			boolean_sat_new_level(sat);
+			if (value == UNASSIGNED) {
+				boolean_sat_assign(sat, literal, NO_REASON);
+			}
+			continue;
+		}
+
+		size_t variable = SIZE_MAX;
+		while (sat->heap_length != 0) {
+			variable = boolean_sat_heap_pop(sat);
+			if (sat->values[variable] == UNASSIGNED) {
+				break;
+			}
+			variable = SIZE_MAX;
+		}
+		if (variable == SIZE_MAX) {
+			for (size_t i = 0; i < sat->variables_count; i++) {
+				sat->model[i] = sat->values[i] == 1;
+			}
+			result = boolean_sat_result_satisfiable;
+			break;
+		}
+
+		boolean_sat_new_level(sat);
+		boolean_sat_assign(sat, (uint32_t)(2 * variable) + !sat->phases[variable], NO_REASON);
+	}
+
+	boolean_sat_backtrack(sat, 0);
+	free(learnt);
+
+	return result;
+}
+
+// the literal's value in the model found by the last satisfiable solve
+bool boolean_sat_value(const struct boolean_sat *sat, int literal) {
+	assert(sat != NULL);
+
+	uint32_t internal = literal_from_external(literal);
+	assert(literal_variable(internal) < sat->variables_count);
+
+	return sat->model[literal_variable(internal)] != ((internal & 1U) != 0);
+}
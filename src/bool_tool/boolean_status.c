@@ -0,0 +1,72 @@
+#include <bool_tool/boolean_status.h>
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+struct boolean_status boolean_status_success(void) {
+	return (struct boolean_status){
+		.type = boolean_status_type_success,
+	};
+}
+
+struct boolean_status boolean_status_failure(const char *format, ...) {
+	assert(format != NULL);
+
+	va_list arguments;
+	va_start(arguments, format);
+	int length = vsnprintf(NULL, 0, format, arguments);
+	va_end(arguments);
+
+	char *formatted = length < 0 ? NULL : malloc((size_t)length + 1);
+	if (formatted == NULL) {
+		// if formatting isn't possible, fallback to the format string itself
+		return (struct boolean_status){
+			.failure = { .literal = format, .type = boolean_status_failure_type_literal },
+			.type = boolean_status_type_failure,
+		};
+	}
+
+	va_start(arguments, format);
+	(void)vsnprintf(formatted, (size_t)length + 1, format, arguments);
+	va_end(arguments);
+
+	return (struct boolean_status){
+		.failure = { .formatted = formatted, .type = boolean_status_failure_type_formatted },
+		.type = boolean_status_type_failure,
+	};
+}
+
+void boolean_status_drop(struct boolean_status *self) {
+	assert(self != NULL);
+
+	if (self->type == boolean_status_type_failure &&
+		self->failure.type == boolean_status_failure_type_formatted) {
+		free(self->failure.formatted);
+	}
+}
+
+const char *boolean_status_message(const struct boolean_status *self) {
+	assert(self != NULL);
+
+	switch (self->type) {
+		case boolean_status_type_success: return "success";
+		case boolean_status_type_failure: {
+			switch (self->failure.type) {
+				case boolean_status_failure_type_literal: return self->failure.literal;
+				case boolean_status_failure_type_formatted: return self->failure.formatted;
+			}
+		} break;
+	}
+
+	return NULL;
+}
+
+void boolean_status_print(const struct boolean_status *self) {
+	assert(self != NULL);
+
+	if (self->type == boolean_status_type_failure) {
+		(void)fprintf(stderr, "Error: %s\n", boolean_status_message(self));
+	}
+}
@@ -0,0 +1,713 @@
+#include <bool_tool/boolean_truth_table_view.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the side of a cell of the karnaugh map, and the height of a character of its header, in pixels
+#define KARNAUGH_MAP_CELL_SIZE 22
+#define KARNAUGH_MAP_CHARACTER_HEIGHT 8
+
+// the limits the view finds what it shows under, on top of what the simplification left cached, as
+// it's filled on the main thread
+#define VIEW_MAXIMUM_BYTES ((size_t)1 << 28)
+#define VIEW_MAXIMUM_IMPLICANTS ((size_t)1 << 16)
+#define VIEW_MAXIMUM_SECONDS 0.5
+
+// a row of the truth table or of the karnaugh map, only made once a view scrolls to it
+#define BOOLEAN_TRUTH_TABLE_ROW_TYPE boolean_truth_table_row_get_type()
+G_DECLARE_FINAL_TYPE(
+	BooleanTruthTableRow,
+	boolean_truth_table_row,
+	BOOLEAN_TRUTH_TABLE,
+	ROW,
+	GObject
+)
+
+struct _BooleanTruthTableRow {
+	GObject parent;
+	guint index;
+};
+
+G_DEFINE_TYPE(BooleanTruthTableRow, boolean_truth_table_row, G_TYPE_OBJECT)
+
+static void boolean_truth_table_row_class_init(BooleanTruthTableRowClass *class) {
+	(void)class;
+}
+
+static void boolean_truth_table_row_init(BooleanTruthTableRow *self) {
+	(void)self;
+}
+
+// consecutive rows, of which only the count is kept, so that the views showing millions of rows
+// only hold the few they show
+#define BOOLEAN_TRUTH_TABLE_ROWS_TYPE boolean_truth_table_rows_get_type()
+G_DECLARE_FINAL_TYPE(
+	BooleanTruthTableRows,
+	boolean_truth_table_rows,
+	BOOLEAN_TRUTH_TABLE,
+	ROWS,
+	GObject
+)
+
+struct _BooleanTruthTableRows {
+	GObject parent;
+	guint count;
+};
+
+static GType boolean_truth_table_rows_get_item_type(GListModel *list) {
+	(void)list;
+
+	return BOOLEAN_TRUTH_TABLE_ROW_TYPE;
+}
+
+static guint boolean_truth_table_rows_get_n_items(GListModel *list) {
+	return BOOLEAN_TRUTH_TABLE_ROWS(list)->count;
+}
+
+static gpointer boolean_truth_table_rows_get_item(GListModel *list, guint position) {
+	if (position >= BOOLEAN_TRUTH_TABLE_ROWS(list)->count) {
+		return NULL;
+	}
+
+	BooleanTruthTableRow *row = g_object_new(BOOLEAN_TRUTH_TABLE_ROW_TYPE, NULL);
+	row->index = position;
+	return row;
+}
+
+static void boolean_truth_table_rows_list_model_init(GListModelInterface *list_model_interface) {
+	list_model_interface->get_item_type = boolean_truth_table_rows_get_item_type;
+	list_model_interface->get_n_items = boolean_truth_table_rows_get_n_items;
+	list_model_interface->get_item = boolean_truth_table_rows_get_item;
+}
+
+G_DEFINE_TYPE_WITH_CODE(
+	BooleanTruthTableRows,
+	boolean_truth_table_rows,
+	G_TYPE_OBJECT,
+	G_IMPLEMENT_INTERFACE(G_TYPE_LIST_MODEL, boolean_truth_table_rows_list_model_init)
+)
+
+static void boolean_truth_table_rows_class_init(BooleanTruthTableRowsClass *class) {
+	(void)class;
+}
+
+static void boolean_truth_table_rows_init(BooleanTruthTableRows *self) {
+	self->count = 0;
+}
+
+static BooleanTruthTableRows *boolean_truth_table_rows_new(guint count) {
+	BooleanTruthTableRows *rows = g_object_new(BOOLEAN_TRUTH_TABLE_ROWS_TYPE, NULL);
+	rows->count = count;
+	return rows;
+}
+
+// has the views bind the rows they show again
+static void boolean_truth_table_rows_refresh(BooleanTruthTableRows *rows) {
+	g_list_model_items_changed(G_LIST_MODEL(rows), 0, rows->count, rows->count);
+}
+
+struct _BooleanTruthTableView {
+	GtkBox parent;
+	GtkLabel *message_label;
+	GtkWidget *content;
+	GtkDropDown *implicant_dropdown;
+	GtkColumnView *column_view;
+	GtkLabel *karnaugh_map_label;
+	GtkWidget *karnaugh_map_window;
+	GtkListView *karnaugh_map_view;
+
+	// the function shown, whose cache the variables, the truth table and the prime implicants are
+	// borrowed from
+	struct boolean_function function;
+	bool has_function;
+	const struct boolean_variables *variables;
+	// the value on row r is bit r % 64 of word r / 64, rows being packed like minterms
+	const uint64_t *truth_table;
+	// null if they didn't fit in the budget
+	const struct boolean_implicants *implicants;
+	// the prime implicant whose rows are highlighted, none if it's past the implicants
+	size_t selected_implicant;
+
+	BooleanTruthTableRows *rows;
+	BooleanTruthTableRows *karnaugh_map_rows;
+	// the items of the implicant dropdown, none followed by the implicants, whose labels are only
+	// made once the dropdown shows them
+	BooleanTruthTableRows *implicant_rows;
+};
+
+G_DEFINE_TYPE(BooleanTruthTableView, boolean_truth_table_view, GTK_TYPE_BOX)
+
+static bool boolean_truth_table_view_value(const BooleanTruthTableView *self, uint64_t row) {
+	return ((self->truth_table[row / 64] >> (row % 64)) & 1U) != 0;
+}
+
+static bool boolean_truth_table_view_highlighted(const BooleanTruthTableView *self, uint64_t row) {
+	if (self->implicants == NULL || self->selected_implicant >= self->implicants->length) {
+		return false;
+	}
+
+	struct boolean_implicant implicant = self->implicants->data[self->selected_implicant];
+	return (row & implicant.mask) == (implicant.value & implicant.mask);
+}
+
+// writes the bits of the gray code of the index, the most significant first, so that neighboring
+// rows and columns of the karnaugh map differ in a single variable
+static void boolean_truth_table_view_gray_code(size_t index, size_t bits_count, char *code) {
+	size_t gray = index ^ (index >> 1);
+	for (size_t i = 0; i < bits_count; i++) {
+		code[i] = ((gray >> (bits_count - 1 - i)) & 1U) != 0 ? '1' : '0';
+	}
+	code[bits_count] = '\0';
+}
+
+static void boolean_truth_table_view_cell_setup(
+	GtkSignalListItemFactory *factory,
+	GtkListItem *item,
+	gpointer user_data
+) {
+	(void)factory;
+	(void)user_data;
+
+	GtkWidget *label = gtk_label_new(NULL);
+	gtk_widget_add_css_class(label, "monospace");
+	gtk_list_item_set_child(item, label);
+}
+
+static void boolean_truth_table_view_cell_set(
+	const BooleanTruthTableView *self,
+	GtkListItem *item,
+	guint row,
+	const char *text
+) {
+	GtkWidget *label = gtk_list_item_get_child(item);
+	gtk_label_set_text(GTK_LABEL(label), text);
+	if (boolean_truth_table_view_highlighted(self, row)) {
+		gtk_widget_add_css_class(label, "highlighted");
+	} else {
+		gtk_widget_remove_css_class(label, "highlighted");
+	}
+}
+
+static void boolean_truth_table_view_row_bind(
+	GtkSignalListItemFactory *factory,
+	GtkListItem *item,
+	gpointer user_data
+) {
+	(void)factory;
+
+	const BooleanTruthTableView *self = user_data;
+	guint row = BOOLEAN_TRUTH_TABLE_ROW(gtk_list_item_get_item(item))->index;
+
+	char text[16];
+	(void)snprintf(text, sizeof(text), "%u", row);
+	boolean_truth_table_view_cell_set(self, item, row, text);
+}
+
+static void boolean_truth_table_view_variable_bind(
+	GtkSignalListItemFactory *factory,
+	GtkListItem *item,
+	gpointer user_data
+) {
+	const BooleanTruthTableView *self = user_data;
+	guint row = BOOLEAN_TRUTH_TABLE_ROW(gtk_list_item_get_item(item))->index;
+
+	// variable j of the variables is bit n - 1 - j of the row
+	size_t variable = GPOINTER_TO_SIZE(g_object_get_data(G_OBJECT(factory), "variable"));
+	size_t bit = self->variables->length - 1 - variable;
+	boolean_truth_table_view_cell_set(self, item, row, ((row >> bit) & 1U) != 0 ? "1" : "0");
+}
+
+static void boolean_truth_table_view_value_bind(
+	GtkSignalListItemFactory *factory,
+	GtkListItem *item,
+	gpointer user_data
+) {
+	(void)factory;
+
+	const BooleanTruthTableView *self = user_data;
+	guint row = BOOLEAN_TRUTH_TABLE_ROW(gtk_list_item_get_item(item))->index;
+
+	bool value = boolean_truth_table_view_value(self, row);
+	boolean_truth_table_view_cell_set(self, item, row, value ? "1" : "0");
+}
+
+static void boolean_truth_table_view_append_column(
+	BooleanTruthTableView *self,
+	const char *title,
+	GCallback bind,
+	size_t variable
+) {
+	GtkListItemFactory *factory = gtk_signal_list_item_factory_new();
+	g_object_set_data(G_OBJECT(factory), "variable", GSIZE_TO_POINTER(variable));
+	g_signal_connect(factory, "setup", G_CALLBACK(boolean_truth_table_view_cell_setup), self);
+	g_signal_connect(factory, "bind", bind, self);
+
+	GtkColumnViewColumn *column = gtk_column_view_column_new(title, factory);
+	gtk_column_view_append_column(self->column_view, column);
+	g_object_unref(column);
+}
+
+// the first variables pick the row of the karnaugh map and the rest pick the column, the first row
+// being a header that labels the columns
+static void boolean_truth_table_view_karnaugh_map_draw(
+	GtkDrawingArea *area,
+	cairo_t *cairo,
+	int width,
+	int height,
+	gpointer user_data
+) {
+	(void)width;
+
+	const BooleanTruthTableView *self = user_data;
+	if (self->truth_table == NULL) {
+		return;
+	}
+
+	guint index = GPOINTER_TO_UINT(g_object_get_data(G_OBJECT(area), "row"));
+	size_t row_bits = self->variables->length / 2;
+	size_t column_bits = self->variables->length - row_bits;
+	size_t columns_count = (size_t)1 << column_bits;
+
+	cairo_select_font_face(cairo, "monospace", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+	cairo_set_font_size(cairo, 12.0);
+
+	char code[BOOLEAN_TRUTH_TABLE_VIEW_KARNAUGH_MAP_VARIABLES_MAXIMUM + 1];
+	if (index == 0) {
+		// the gray codes of the columns are written upwards to fit in the width of a cell
+		cairo_set_source_rgba(cairo, 1.0, 1.0, 1.0, 0.7);
+		for (size_t column = 0; column < columns_count; column++) {
+			boolean_truth_table_view_gray_code(column, column_bits, code);
+			cairo_save(cairo);
+			cairo_move_to(
+				cairo,
+				((double)column + 0.7) * KARNAUGH_MAP_CELL_SIZE,
+				(double)height - 4.0
+			);
+			cairo_rotate(cairo, -G_PI / 2.0);
+			cairo_show_text(cairo, code);
+			cairo_restore(cairo);
+		}
+		return;
+	}
+
+	uint64_t row_gray = (uint64_t)(index - 1) ^ ((uint64_t)(index - 1) >> 1);
+	for (size_t column = 0; column < columns_count; column++) {
+		uint64_t row = (row_gray << column_bits) | (column ^ (column >> 1));
+		bool value = boolean_truth_table_view_value(self, row);
+		bool highlighted = boolean_truth_table_view_highlighted(self, row);
+
+		double x = (double)column * KARNAUGH_MAP_CELL_SIZE;
+		if (highlighted) {
+			cairo_set_source_rgb(cairo, 148.0 / 255.0, 226.0 / 255.0, 213.0 / 255.0);
+		} else {
+			cairo_set_source_rgba(cairo, 1.0, 1.0, 1.0, value ? 0.16 : 0.04);
+		}
+		cairo_rectangle(
+			cairo,
+			x + 1.0,
+			1.0,
+			KARNAUGH_MAP_CELL_SIZE - 2.0,
+			KARNAUGH_MAP_CELL_SIZE - 2.0
+		);
+		cairo_fill(cairo);
+
+		if (value) {
+			if (highlighted) {
+				cairo_set_source_rgb(cairo, 17.0 / 255.0, 17.0 / 255.0, 27.0 / 255.0);
+			} else {
+				cairo_set_source_rgba(cairo, 1.0, 1.0, 1.0, 0.9);
+			}
+			cairo_move_to(cairo, x + 7.0, KARNAUGH_MAP_CELL_SIZE - 7.0);
+			cairo_show_text(cairo, "1");
+		}
+	}
+}
+
+static void boolean_truth_table_view_karnaugh_map_setup(
+	GtkSignalListItemFactory *factory,
+	GtkListItem *item,
+	gpointer user_data
+) {
+	(void)factory;
+
+	GtkWidget *box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 6);
+
+	GtkWidget *label = gtk_label_new(NULL);
+	gtk_label_set_xalign(GTK_LABEL(label), 0.0F);
+	gtk_widget_set_valign(label, GTK_ALIGN_END);
+	gtk_widget_add_css_class(label, "monospace");
+	gtk_box_append(GTK_BOX(box), label);
+
+	GtkWidget *area = gtk_drawing_area_new();
+	gtk_drawing_area_set_draw_func(
+		GTK_DRAWING_AREA(area),
+		boolean_truth_table_view_karnaugh_map_draw,
+		user_data,
+		NULL
+	);
+	gtk_box_append(GTK_BOX(box), area);
+
+	gtk_list_item_set_child(item, box);
+}
+
+static void boolean_truth_table_view_karnaugh_map_bind(
+	GtkSignalListItemFactory *factory,
+	GtkListItem *item,
+	gpointer user_data
+) {
+	(void)factory;
+
+	const BooleanTruthTableView *self = user_data;
+	guint index = BOOLEAN_TRUTH_TABLE_ROW(gtk_list_item_get_item(item))->index;
+	size_t variables_count = self->variables->length;
+	size_t row_bits = variables_count / 2;
+	size_t column_bits = variables_count - row_bits;
+
+	GtkWidget *label = gtk_widget_get_first_child(gtk_list_item_get_child(item));
+	GtkWidget *area = gtk_widget_get_next_sibling(label);
+
+	// the header names the variables of the rows and of the columns, which is wider than the gray
+	// codes labeling the rows
+	char text[BOOLEAN_TRUTH_TABLE_VIEW_KARNAUGH_MAP_VARIABLES_MAXIMUM + 2];
+	int height = KARNAUGH_MAP_CELL_SIZE;
+	if (index == 0) {
+		memcpy(text, self->variables->data, row_bits * sizeof(*text));
+		text[row_bits] = '\\';
+		memcpy(&text[row_bits + 1], &self->variables->data[row_bits], column_bits * sizeof(*text));
+		text[variables_count + 1] = '\0';
+
+		int header_height = (int)column_bits * KARNAUGH_MAP_CHARACTER_HEIGHT + 8;
+		height = header_height > height ? header_height : height;
+	} else {
+		boolean_truth_table_view_gray_code(index - 1, row_bits, text);
+	}
+	gtk_label_set_width_chars(GTK_LABEL(label), (int)variables_count + 1);
+	gtk_label_set_text(GTK_LABEL(label), text);
+
+	g_object_set_data(G_OBJECT(area), "row", GUINT_TO_POINTER(index));
+	gtk_drawing_area_set_content_width(
+		GTK_DRAWING_AREA(area),
+		(int)(((size_t)1 << column_bits) * KARNAUGH_MAP_CELL_SIZE)
+	);
+	gtk_drawing_area_set_content_height(GTK_DRAWING_AREA(area), height);
+	gtk_widget_queue_draw(area);
+}
+
+static void boolean_truth_table_view_implicant_setup(
+	GtkSignalListItemFactory *factory,
+	GtkListItem *item,
+	gpointer user_data
+) {
+	(void)factory;
+	(void)user_data;
+
+	GtkWidget *label = gtk_label_new(NULL);
+	gtk_label_set_xalign(GTK_LABEL(label), 0.0F);
+	gtk_list_item_set_child(item, label);
+}
+
+// the first item highlights none of the implicants, the others are labeled with theirs
+static void boolean_truth_table_view_implicant_bind(
+	GtkSignalListItemFactory *factory,
+	GtkListItem *item,
+	gpointer user_data
+) {
+	(void)factory;
+
+	const BooleanTruthTableView *self = user_data;
+	guint index = BOOLEAN_TRUTH_TABLE_ROW(gtk_list_item_get_item(item))->index;
+	GtkLabel *label = GTK_LABEL(gtk_list_item_get_child(item));
+
+	if (index == 0 || self->implicants == NULL || index > self->implicants->length) {
+		gtk_label_set_text(label, "None");
+		return;
+	}
+
+	struct boolean_expression expression =
+		boolean_expression_from_implicant(self->implicants->data[index - 1], self->variables);
+	char *expression_string = boolean_expression_to_string(&expression);
+	gtk_label_set_text(label, expression_string != NULL ? expression_string : "?");
+	free(expression_string);
+	boolean_expression_drop(&expression);
+}
+
+// selecting an implicant refreshes the rows, so this is done once they're set
+static void boolean_truth_table_view_set_implicant_rows(
+	BooleanTruthTableView *self,
+	size_t implicants_count
+) {
+	g_clear_object(&self->implicant_rows);
+	self->implicant_rows = boolean_truth_table_rows_new((guint)(implicants_count + 1));
+	gtk_drop_down_set_model(self->implicant_dropdown, G_LIST_MODEL(self->implicant_rows));
+}
+
+static void boolean_truth_table_view_dispose(GObject *gobject) {
+	BooleanTruthTableView *self = BOOLEAN_TRUTH_TABLE_VIEW(gobject);
+
+	gtk_widget_dispose_template(GTK_WIDGET(gobject), BOOLEAN_TRUTH_TABLE_VIEW_TYPE);
+
+	g_clear_object(&self->rows);
+	g_clear_object(&self->karnaugh_map_rows);
+	g_clear_object(&self->implicant_rows);
+
+	G_OBJECT_CLASS(boolean_truth_table_view_parent_class)->dispose(gobject);
+}
+
+static void boolean_truth_table_view_finalize(GObject *gobject) {
+	BooleanTruthTableView *self = BOOLEAN_TRUTH_TABLE_VIEW(gobject);
+
+	if (self->has_function) {
+		boolean_function_drop(&self->function);
+	}
+
+	G_OBJECT_CLASS(boolean_truth_table_view_parent_class)->finalize(gobject);
+}
+
+static void boolean_truth_table_view_class_init(BooleanTruthTableViewClass *class) {
+	G_OBJECT_CLASS(class)->dispose = boolean_truth_table_view_dispose;
+	G_OBJECT_CLASS(class)->finalize = boolean_truth_table_view_finalize;
+
+	GtkWidgetClass *widget_class = GTK_WIDGET_CLASS(class);
+
+	gtk_widget_class_set_template_from_resource(
+		widget_class,
+		"/com/github/TarekSaeed0/bool_tool/ui/boolean_truth_table_view.ui"
+	);
+
+	gtk_widget_class_bind_template_child(widget_class, BooleanTruthTableView, message_label);
+	gtk_widget_class_bind_template_child(widget_class, BooleanTruthTableView, content);
+	gtk_widget_class_bind_template_child(widget_class, BooleanTruthTableView, implicant_dropdown);
+	gtk_widget_class_bind_template_child(widget_class, BooleanTruthTableView, column_view);
+	gtk_widget_class_bind_template_child(widget_class, BooleanTruthTableView, karnaugh_map_label);
+	gtk_widget_class_bind_template_child(
+		widget_class,
+		BooleanTruthTableView,
+		karnaugh_map_window
+	);
+	gtk_widget_class_bind_template_child(widget_class, BooleanTruthTableView, karnaugh_map_view);
+}
+
+static void boolean_truth_table_view_init(BooleanTruthTableView *self) {
+	self->has_function = false;
+	self->variables = NULL;
+	self->truth_table = NULL;
+	self->implicants = NULL;
+	self->selected_implicant = SIZE_MAX;
+	self->rows = NULL;
+	self->karnaugh_map_rows = NULL;
+	self->implicant_rows = NULL;
+
+	gtk_widget_init_template(GTK_WIDGET(self));
+
+	GtkListItemFactory *implicant_factory = gtk_signal_list_item_factory_new();
+	g_signal_connect(
+		implicant_factory,
+		"setup",
+		G_CALLBACK(boolean_truth_table_view_implicant_setup),
+		self
+	);
+	g_signal_connect(
+		implicant_factory,
+		"bind",
+		G_CALLBACK(boolean_truth_table_view_implicant_bind),
+		self
+	);
+	gtk_drop_down_set_factory(self->implicant_dropdown, implicant_factory);
+	g_object_unref(implicant_factory);
+	boolean_truth_table_view_set_implicant_rows(self, 0);
+
+	GtkListItemFactory *factory = gtk_signal_list_item_factory_new();
+	g_signal_connect(
+		factory,
+		"setup",
+		G_CALLBACK(boolean_truth_table_view_karnaugh_map_setup),
+		self
+	);
+	g_signal_connect(
+		factory,
+		"bind",
+		G_CALLBACK(boolean_truth_table_view_karnaugh_map_bind),
+		self
+	);
+	gtk_list_view_set_factory(self->karnaugh_map_view, factory);
+	g_object_unref(factory);
+}
+
+static void boolean_truth_table_view_show_message(
+	BooleanTruthTableView *self,
+	const char *message
+) {
+	gtk_label_set_text(self->message_label, message);
+	gtk_widget_set_visible(GTK_WIDGET(self->message_label), true);
+}
+
+void boolean_truth_table_view_clear(BooleanTruthTableView *self) {
+	assert(self != NULL);
+
+	gtk_column_view_set_model(self->column_view, NULL);
+	gtk_list_view_set_model(self->karnaugh_map_view, NULL);
+	GListModel *columns = gtk_column_view_get_columns(self->column_view);
+	while (g_list_model_get_n_items(columns) != 0) {
+		GtkColumnViewColumn *column = g_list_model_get_item(columns, 0);
+		gtk_column_view_remove_column(self->column_view, column);
+		g_object_unref(column);
+	}
+	g_clear_object(&self->rows);
+	g_clear_object(&self->karnaugh_map_rows);
+
+	self->variables = NULL;
+	self->truth_table = NULL;
+	self->implicants = NULL;
+	self->selected_implicant = SIZE_MAX;
+	boolean_truth_table_view_set_implicant_rows(self, 0);
+
+	// dropped only once nothing borrows from its cache
+	if (self->has_function) {
+		boolean_function_drop(&self->function);
+		self->has_function = false;
+	}
+
+	gtk_label_set_text(self->message_label, "");
+	gtk_widget_set_visible(GTK_WIDGET(self->message_label), false);
+	gtk_widget_set_visible(self->content, false);
+}
+
+// shows the truth table and the karnaugh map of the function, which are read from the packed truth
+// table in its cache as the views scroll, its prime implicants being listed for highlighting, the
+// view takes the function, keeping it until it's cleared
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+void boolean_truth_table_view_set_function(
+	BooleanTruthTableView *self,
+	struct boolean_function function
+) {
+	assert(self != NULL);
+
+	boolean_truth_table_view_clear(self);
+
+	self->function = function;
+	self->has_function = true;
+	struct boolean_budget budget =
+		boolean_budget_new(VIEW_MAXIMUM_BYTES, VIEW_MAXIMUM_IMPLICANTS, VIEW_MAXIMUM_SECONDS);
+
+	const struct boolean_variables *variables = boolean_function_variables(&self->function);
+	if (variables->length > BOOLEAN_TRUTH_TABLE_VIEW_VARIABLES_MAXIMUM) {
+		char message[128];
+		(void)snprintf(
+			message,
+			sizeof(message),
+			"can't show the truth table of a function of more than %d variables",
+			BOOLEAN_TRUTH_TABLE_VIEW_VARIABLES_MAXIMUM
+		);
+		boolean_truth_table_view_show_message(self, message);
+		return;
+	}
+
+	const uint64_t *truth_table;
+	struct boolean_status status =
+		boolean_function_truth_table(&self->function, &budget, &truth_table);
+	if (status.type != boolean_status_type_success) {
+		boolean_truth_table_view_show_message(self, boolean_status_message(&status));
+		boolean_status_drop(&status);
+		return;
+	}
+	self->truth_table = truth_table;
+	self->variables = variables;
+
+	// the implicants are only highlighted, so the table is still shown if they exceed the budget
+	const struct boolean_implicants *implicants;
+	status = boolean_function_prime_implicants(&self->function, &budget, &implicants);
+	if (status.type == boolean_status_type_success) {
+		self->implicants = implicants;
+	} else {
+		boolean_truth_table_view_show_message(self, boolean_status_message(&status));
+		boolean_status_drop(&status);
+	}
+
+	size_t rows_count = (size_t)1 << variables->length;
+
+	boolean_truth_table_view_append_column(
+		self,
+		"#",
+		G_CALLBACK(boolean_truth_table_view_row_bind),
+		0
+	);
+	for (size_t i = 0; i < variables->length; i++) {
+		char title[2] = { variables->data[i], '\0' };
+		boolean_truth_table_view_append_column(
+			self,
+			title,
+			G_CALLBACK(boolean_truth_table_view_variable_bind),
+			i
+		);
+	}
+	boolean_truth_table_view_append_column(
+		self,
+		"f",
+		G_CALLBACK(boolean_truth_table_view_value_bind),
+		0
+	);
+
+	self->rows = boolean_truth_table_rows_new((guint)rows_count);
+	GtkNoSelection *selection = gtk_no_selection_new(G_LIST_MODEL(g_object_ref(self->rows)));
+	gtk_column_view_set_model(self->column_view, GTK_SELECTION_MODEL(selection));
+	g_object_unref(selection);
+
+	if (variables->length <= BOOLEAN_TRUTH_TABLE_VIEW_KARNAUGH_MAP_VARIABLES_MAXIMUM) {
+		size_t row_bits = variables->length / 2;
+		self->karnaugh_map_rows = boolean_truth_table_rows_new((guint)((1U << row_bits) + 1));
+		selection = gtk_no_selection_new(G_LIST_MODEL(g_object_ref(self->karnaugh_map_rows)));
+		gtk_list_view_set_model(self->karnaugh_map_view, GTK_SELECTION_MODEL(selection));
+		g_object_unref(selection);
+
+		gtk_widget_set_visible(GTK_WIDGET(self->karnaugh_map_label), false);
+		gtk_widget_set_visible(self->karnaugh_map_window, true);
+	} else {
+		char message[128];
+		(void)snprintf(
+			message,
+			sizeof(message),
+			"can't show the karnaugh map of a function of more than %d variables",
+			BOOLEAN_TRUTH_TABLE_VIEW_KARNAUGH_MAP_VARIABLES_MAXIMUM
+		);
+		gtk_label_set_text(self->karnaugh_map_label, message);
+		gtk_widget_set_visible(GTK_WIDGET(self->karnaugh_map_label), true);
+		gtk_widget_set_visible(self->karnaugh_map_window, false);
+	}
+
+	boolean_truth_table_view_set_implicant_rows(
+		self,
+		self->implicants != NULL ? self->implicants->length : 0
+	);
+
+	gtk_widget_set_visible(self->content, true);
+}
+
+G_MODULE_EXPORT void implicant_dropdown_selected_changed(
+	GtkDropDown *self,
+	GParamSpec *pspec,
+	gpointer user_data
+) {
+	(void)pspec;
+	(void)user_data;
+
+	BooleanTruthTableView *view = BOOLEAN_TRUTH_TABLE_VIEW(
+		gtk_widget_get_ancestor(GTK_WIDGET(self), BOOLEAN_TRUTH_TABLE_VIEW_TYPE)
+	);
+
+	// the first item highlights none of the implicants
+	guint selected = gtk_drop_down_get_selected(self);
+	if (selected == GTK_INVALID_LIST_POSITION || selected == 0) {
+		view->selected_implicant = SIZE_MAX;
+	} else {
+		view->selected_implicant = (size_t)selected - 1;
+	}
+
+	if (view->rows != NULL) {
+		boolean_truth_table_rows_refresh(view->rows);
+	}
+	if (view->karnaugh_map_rows != NULL) {
+		boolean_truth_table_rows_refresh(view->karnaugh_map_rows);
+	}
+}
@@ -129,8 +129,7 @@ void boolean_variables_from_expression_(
 			boolean_environment_set_variable(environment, expression->variable.name, true);
 		} break;
 		case boolean_expression_type_operation: {
-			size_t arity = boolean_operation_type_arity(expression->operation.type);
-			for (size_t i = 0; i < arity; i++) {
+			for (size_t i = 0; i < expression->operation.operands_count; i++) {
 				boolean_variables_from_expression_(&expression->operation.operands[i], environment);
 			}
 		} break;
@@ -144,17 +143,13 @@ struct boolean_variables boolean_variables_from_expression(
 	struct boolean_environment environment = boolean_environment_new();
 	boolean_variables_from_expression_(expression, &environment);
 
-#define VARIABLES_COUNT (('z' - 'a' + 1) + ('Z' - 'A' + 1))
-#define VARIABLE_NAME_FROM_INDEX(index)                                                            \
-	(char)((index) < ('z' - 'a' + 1) ? 'a' + (index) : 'A' + ((index) - ('z' - 'a' + 1)))
-
 	struct boolean_variables variables = {
-		.data = malloc(VARIABLES_COUNT),
+		.data = malloc(BOOLEAN_ENVIRONMENT_VARIABLES_COUNT),
 		.length = 0,
 	};
-	for (size_t i = 0; i < VARIABLES_COUNT; i++) {
+	for (size_t i = 0; i < BOOLEAN_ENVIRONMENT_VARIABLES_COUNT; i++) {
 		if ((environment.variables >> i) & 1U) {
-			variables.data[variables.length++] = VARIABLE_NAME_FROM_INDEX(i);
+			variables.data[variables.length++] = boolean_environment_variable_name(i);
 		}
 	}
 